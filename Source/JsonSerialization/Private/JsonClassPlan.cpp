@@ -0,0 +1,87 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "JsonClassPlan.h"
+
+#include "Hash/CityHash.h"
+#include "Misc/ScopeRWLock.h"
+#include "UObject/UnrealType.h"
+
+static FRWLock PlansLock;
+static TMap<const UStruct*, TSharedRef<const FJsonClassPlan>> Plans;
+
+static bool ShouldSerializeProperty(const FProperty* Property)
+{
+	// Don't include "UberGraphFrame" or any transient properties
+	return Property->GetName() != "UberGraphFrame"
+		&& !Property->HasAnyPropertyFlags(CPF_Transient);
+}
+
+static TSharedRef<FJsonClassPlan> BuildPlan(const UStruct* Struct)
+{
+	TSharedRef<FJsonClassPlan> Plan = MakeShared<FJsonClassPlan>();
+	Plan->Struct = Struct;
+
+	FString Schema;
+	for (TFieldIterator<FProperty> PropertyItr(Struct); PropertyItr; ++PropertyItr)
+	{
+		FProperty* Property = *PropertyItr;
+		if (!ShouldSerializeProperty(Property))
+		{
+			Plan->UnwrittenPropertyTests.Emplace(Property);
+			Plan->UnwrittenPropertyNames.Add(Property->GetAuthoredName());
+			continue;
+		}
+
+		Plan->Properties.Add(Property);
+		Plan->PropertyTests.Emplace(Property);
+		const FString& Name = Plan->PropertyNames.Add_GetRef(Property->GetAuthoredName());
+
+		// Container element types are only in the extended text, e.g. "TArray" + "<int32>"
+		FString ExtendedType;
+		Schema += Name;
+		Schema += TEXT(':');
+		Schema += Property->GetCPPType(&ExtendedType);
+		Schema += ExtendedType;
+		Schema += TEXT(';');
+	}
+
+	const uint64 Hash = CityHash64(reinterpret_cast<const char*>(*Schema), Schema.Len() * sizeof(TCHAR));
+	Plan->Fingerprint = FString::Printf(TEXT("%016llx"), Hash);
+	return Plan;
+}
+
+TSharedRef<const FJsonClassPlan> FJsonClassPlan::Get(const UStruct* Struct)
+{
+	check(Struct);
+
+	{
+		FReadScopeLock ReadLock(PlansLock);
+		const TSharedRef<const FJsonClassPlan>* Found = Plans.Find(Struct);
+		if (Found && (*Found)->Struct.Get() == Struct)
+		{
+			return *Found;
+		}
+	}
+
+	for (;;)
+	{
+		// Plans are built outside the lock, so a migration registered meanwhile may be missing from this one. Its
+		// FlushAll may also have run already, so only cache the plan if no migration changed while it was built
+		const uint32 Generation = FJsonMigrationRegistry::GetGeneration();
+		TSharedRef<FJsonClassPlan> Plan = BuildPlan(Struct);
+		FJsonMigrationRegistry::ResolveMigrations(*Plan);
+
+		FWriteScopeLock WriteLock(PlansLock);
+		if (FJsonMigrationRegistry::GetGeneration() == Generation)
+		{
+			Plans.Add(Struct, Plan);
+			return Plan;
+		}
+	}
+}
+
+void FJsonClassPlan::FlushAll()
+{
+	FWriteScopeLock WriteLock(PlansLock);
+	Plans.Empty();
+}
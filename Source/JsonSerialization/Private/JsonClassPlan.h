@@ -0,0 +1,85 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "JsonLeafCodec.h"
+#include "JsonMigrationRegistry.h"
+#include "UObject/UnrealType.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+#include <atomic>
+
+/** A property with its container kind and leaf type resolved, so the serializer can branch without casting. */
+struct FPropertyTest {
+	FPropertyTest(FProperty* Property) {
+		Raw = Property;
+		AsArray = CastField< FArrayProperty>(Property);
+		AsSet = CastField< FSetProperty>(Property);
+		AsMap = CastField< FMapProperty>(Property);
+		AsStruct = CastField< FStructProperty>(Property);
+		AsObject = CastField< FObjectProperty>(Property);
+		Leaf = FJsonLeafCodec::Classify(Property);
+	};
+
+	FProperty* Raw;
+	FArrayProperty* AsArray;
+	FSetProperty* AsSet;
+	FMapProperty* AsMap;
+	FStructProperty* AsStruct;
+	FObjectProperty* AsObject;
+	EJsonLeafType Leaf;
+};
+
+/**
+ * The properties of a class or struct that the serializer visits, resolved once and cached per struct.
+ * Apart from learned size statistics, plans don't change once built; a rebuilt struct gets a fresh plan.
+ */
+struct FJsonClassPlan
+{
+	/** Struct the plan was built from. Goes stale when the struct is garbage collected. */
+	TWeakObjectPtr<const UStruct> Struct;
+
+	/** Serialized properties in field order. This order is the positional layout. */
+	TArray<FProperty*> Properties;
+
+	/** Properties classified for the serializer, built once with the plan. */
+	TArray<FPropertyTest> PropertyTests;
+
+	/** Authored names of Properties, used as json keys. */
+	TArray<FString> PropertyNames;
+
+	/**
+	 * Properties the serializer skips, i.e. transient ones and "UberGraphFrame", with their authored names. Keyed
+	 * bodies that have them are still read into them, as the reader did before it used plans.
+	 */
+	TArray<FPropertyTest> UnwrittenPropertyTests;
+	TArray<FString> UnwrittenPropertyNames;
+
+	/** Hash of the property names, types and order, as a hex string. */
+	FString Fingerprint;
+
+	/** A migration registered for one of Properties, see FJsonMigrationRegistry. */
+	struct FMigration
+	{
+		/** Key older versions wrote the property under, or empty if the property was retyped under its current key. */
+		FString OldKey;
+
+		/** Json type of retyped values. */
+		EJson OldType = EJson::None;
+
+		FJsonValueConverter Converter;
+	};
+
+	/** Migrations of each of Properties. Empty unless the struct or one of its parents has migrations registered. */
+	TArray<TArray<FMigration>> Migrations;
+
+	/** Length of the json text recently written for objects of this class, used to size the output up front. */
+	mutable std::atomic<int32> ExpectedTextLength{0};
+
+	/** Returns the cached plan for Struct, building it on first use. Safe to call from any thread. */
+	static TSharedRef<const FJsonClassPlan> Get(const UStruct* Struct);
+
+	/** Drops every cached plan, e.g. after classes are reinstanced. */
+	static void FlushAll();
+};
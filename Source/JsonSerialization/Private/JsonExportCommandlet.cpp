@@ -0,0 +1,278 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "JsonExportCommandlet.h"
+
+#include "JsonClassPlan.h"
+#include "JsonSerialization.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/SoftObjectPath.h"
+#include "UObject/UObjectGlobals.h"
+
+#include <atomic>
+
+// Export keys of the last export, so unchanged assets can be skipped
+static const TCHAR* JsonExportHashesFile = TEXT("JsonExportHashes.json");
+
+// Bump when the serializer's output changes, so the next run re-exports everything. 2: floats are written with
+// their shortest digits, export keys include the class
+static const int32 JsonExportFormatVersion = 2;
+
+UJsonExportCommandlet::UJsonExportCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+	ShowErrorCount = true;
+}
+
+// Options that change the output of an unchanged asset
+static FString GetExportOptions(bool bIncludeObjectClasses)
+{
+	return FString::Printf(TEXT("IncludeClasses=%d"), bIncludeObjectClasses ? 1 : 0);
+}
+
+// An asset's json also depends on its class, which may live in other packages: the class layout, and the defaults of
+// the blueprint classes it derives from, which fill in every property the asset doesn't override. Native defaults
+// only change with a new build, so re-export with -Full after one that changes them
+static FString GetClassExportKey(IAssetRegistry& AssetRegistry, const UClass* Class)
+{
+	FString Key = FJsonClassPlan::Get(Class)->Fingerprint;
+	for (const UClass* Super = Class; Super != nullptr && !Super->HasAnyClassFlags(CLASS_Native); Super = Super->GetSuperClass())
+	{
+		if (TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(Super->GetPackage()->GetFName()))
+		{
+			Key += TEXT('-');
+			Key += LexToString(PackageData->GetPackageSavedHash());
+		}
+	}
+	return Key;
+}
+
+// Hashes written with a different format version or different options are ignored, since their files would differ
+static void LoadExportHashes(const FString& Path, const FString& Options, TMap<FString, FString>& OutHashes)
+{
+	FString Text;
+	TSharedPtr<FJsonObject> JsonObject;
+	if (!FFileHelper::LoadFileToString(Text, *Path)
+		|| !FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Text), JsonObject)
+		|| !JsonObject.IsValid())
+	{
+		return;
+	}
+
+	int32 Version = 0;
+	FString PreviousOptions;
+	const TSharedPtr<FJsonObject>* HashesObject = nullptr;
+	if (!JsonObject->TryGetNumberField(TEXT("Version"), Version)
+		|| Version != JsonExportFormatVersion
+		|| !JsonObject->TryGetStringField(TEXT("Options"), PreviousOptions)
+		|| PreviousOptions != Options
+		|| !JsonObject->TryGetObjectField(TEXT("Hashes"), HashesObject))
+	{
+		UE_LOG(LogJsonSerialization, Display, TEXT("%s was written by another format version or with other options, exporting everything"), *Path);
+		return;
+	}
+
+	OutHashes.Reserve((*HashesObject)->Values.Num());
+	for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : (*HashesObject)->Values)
+	{
+		OutHashes.Add(Pair.Key, Pair.Value->AsString());
+	}
+}
+
+static bool SaveExportHashes(const FString& Path, const FString& Options, const TMap<FString, FString>& Hashes)
+{
+	TSharedPtr<FJsonObject> HashesObject = MakeShared<FJsonObject>();
+	HashesObject->Values.Reserve(Hashes.Num());
+	for (const TPair<FString, FString>& Pair : Hashes)
+	{
+		HashesObject->SetStringField(Pair.Key, Pair.Value);
+	}
+
+	TSharedPtr<FJsonObject> JsonObject = MakeShared<FJsonObject>();
+	JsonObject->SetNumberField(TEXT("Version"), JsonExportFormatVersion);
+	JsonObject->SetStringField(TEXT("Options"), Options);
+	JsonObject->SetObjectField(TEXT("Hashes"), HashesObject);
+
+	FString Text;
+	FJsonSerializer::Serialize(JsonObject.ToSharedRef(), TJsonWriterFactory<>::Create(&Text));
+	return FFileHelper::SaveStringToFile(Text, *Path, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+}
+
+int32 UJsonExportCommandlet::Main(const FString& Params)
+{
+	FString PathsValue = TEXT("/Game");
+	FString ClassesValue;
+	FString OutputDirectory = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("JsonExport"));
+	int32 BatchSize = 256;
+
+	FParse::Value(*Params, TEXT("Paths="), PathsValue);
+	FParse::Value(*Params, TEXT("Classes="), ClassesValue);
+	FParse::Value(*Params, TEXT("Output="), OutputDirectory);
+	FParse::Value(*Params, TEXT("BatchSize="), BatchSize);
+	const bool bIncludeObjectClasses = FParse::Param(*Params, TEXT("IncludeClasses"));
+	const bool bFullExport = FParse::Param(*Params, TEXT("Full"));
+	BatchSize = FMath::Max(BatchSize, 1);
+
+	TArray<FString> PackagePaths;
+	PathsValue.ParseIntoArray(PackagePaths, TEXT("+"));
+	TArray<FString> ClassPaths;
+	ClassesValue.ParseIntoArray(ClassPaths, TEXT("+"));
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	AssetRegistry.SearchAllAssets(true);
+
+	FARFilter Filter;
+	Filter.bRecursivePaths = true;
+	Filter.bRecursiveClasses = true;
+	for (const FString& PackagePath : PackagePaths)
+	{
+		Filter.PackagePaths.Add(FName(*PackagePath));
+	}
+	for (const FString& ClassPath : ClassPaths)
+	{
+		FTopLevelAssetPath ClassAssetPath;
+		if (!ClassAssetPath.TrySetPath(ClassPath))
+		{
+			UE_LOG(LogJsonSerialization, Error, TEXT("Invalid class path %s"), *ClassPath);
+			return 1;
+		}
+		Filter.ClassPaths.Add(ClassAssetPath);
+	}
+
+	TArray<FAssetData> Assets;
+	AssetRegistry.GetAssets(Filter, Assets);
+
+	const FString HashesPath = FPaths::Combine(OutputDirectory, JsonExportHashesFile);
+	const FString ExportOptions = GetExportOptions(bIncludeObjectClasses);
+	TMap<FString, FString> PreviousHashes;
+	if (!bFullExport)
+	{
+		LoadExportHashes(HashesPath, ExportOptions, PreviousHashes);
+	}
+
+	// Skip assets whose package and class haven't changed since an export with the same options and whose output is
+	// still there. The export key is the package hash followed by the class key
+	TMap<FString, FString> Hashes;
+	TMap<FTopLevelAssetPath, FString> ClassKeys;
+	TArray<FAssetData> AssetsToExport;
+	TArray<FString> OutputPaths;
+	for (const FAssetData& Asset : Assets)
+	{
+		const FString OutputPath = FPaths::Combine(OutputDirectory, Asset.PackagePath.ToString(), Asset.AssetName.ToString() + TEXT(".json"));
+		const FString ObjectPath = Asset.GetObjectPathString();
+
+		FString* ClassKey = ClassKeys.Find(Asset.AssetClassPath);
+		if (ClassKey == nullptr)
+		{
+			const UClass* Class = FSoftClassPath(Asset.AssetClassPath.ToString()).TryLoadClass<UObject>();
+			ClassKey = &ClassKeys.Add(Asset.AssetClassPath, Class ? GetClassExportKey(AssetRegistry, Class) : FString());
+		}
+
+		FString Hash;
+		TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(Asset.PackageName);
+		if (PackageData && !ClassKey->IsEmpty())
+		{
+			Hash = LexToString(PackageData->GetPackageSavedHash()) + TEXT('/') + *ClassKey;
+		}
+
+		const FString* PreviousHash = PreviousHashes.Find(ObjectPath);
+		if (!Hash.IsEmpty() && PreviousHash && *PreviousHash == Hash && IFileManager::Get().FileExists(*OutputPath))
+		{
+			Hashes.Add(ObjectPath, Hash);
+			continue;
+		}
+
+		if (!Hash.IsEmpty())
+		{
+			Hashes.Add(ObjectPath, Hash);
+		}
+		AssetsToExport.Add(Asset);
+		OutputPaths.Add(OutputPath);
+	}
+
+	UE_LOG(LogJsonSerialization, Display, TEXT("Exporting %d of %d assets to %s"), AssetsToExport.Num(), Assets.Num(), *OutputDirectory);
+
+	const double StartTime = FPlatformTime::Seconds();
+	std::atomic<int64> NumBytes(0);
+	std::atomic<int32> NumFailed(0);
+	TArray<bool> Failed;
+	Failed.SetNumZeroed(AssetsToExport.Num());
+
+	for (int32 BatchStart = 0; BatchStart < AssetsToExport.Num(); BatchStart += BatchSize)
+	{
+		const int32 BatchEnd = FMath::Min(BatchStart + BatchSize, AssetsToExport.Num());
+
+		// Queue the whole batch so package reads overlap, then wait for all of it
+		for (int32 i = BatchStart; i < BatchEnd; ++i)
+		{
+			LoadPackageAsync(AssetsToExport[i].PackageName.ToString());
+		}
+		FlushAsyncLoading();
+
+		TArray<UObject*> BatchObjects;
+		BatchObjects.Reserve(BatchEnd - BatchStart);
+		for (int32 i = BatchStart; i < BatchEnd; ++i)
+		{
+			BatchObjects.Add(AssetsToExport[i].GetAsset());
+		}
+
+		ParallelFor(BatchObjects.Num(), [&](int32 BatchIndex)
+		{
+			const int32 AssetIndex = BatchStart + BatchIndex;
+			const UObject* Object = BatchObjects[BatchIndex];
+			if (Object == nullptr)
+			{
+				UE_LOG(LogJsonSerialization, Warning, TEXT("Failed to load %s"), *AssetsToExport[AssetIndex].GetObjectPathString());
+				Failed[AssetIndex] = true;
+				NumFailed++;
+				return;
+			}
+
+			FString Text;
+			FJsonSerializer::Serialize(FJsonSerializationModule::SerializeUObjectToJson(Object, bIncludeObjectClasses).ToSharedRef(), TJsonWriterFactory<>::Create(&Text));
+
+			FTCHARToUTF8 Utf8(*Text, Text.Len());
+			if (!FFileHelper::SaveArrayToFile(TArrayView<const uint8>((const uint8*)Utf8.Get(), Utf8.Length()), *OutputPaths[AssetIndex]))
+			{
+				UE_LOG(LogJsonSerialization, Warning, TEXT("Failed to write %s"), *OutputPaths[AssetIndex]);
+				Failed[AssetIndex] = true;
+				NumFailed++;
+				return;
+			}
+			NumBytes += Utf8.Length();
+		});
+
+		BatchObjects.Empty();
+		CollectGarbage(RF_NoFlags);
+
+		UE_LOG(LogJsonSerialization, Display, TEXT("Exported %d/%d"), BatchEnd, AssetsToExport.Num());
+	}
+
+	// Failed assets are left out of the hash file so the next run retries them
+	for (int32 i = 0; i < AssetsToExport.Num(); ++i)
+	{
+		if (Failed[i])
+		{
+			Hashes.Remove(AssetsToExport[i].GetObjectPathString());
+		}
+	}
+	SaveExportHashes(HashesPath, ExportOptions, Hashes);
+
+	const double Seconds = FMath::Max(FPlatformTime::Seconds() - StartTime, UE_SMALL_NUMBER);
+	const int32 NumWritten = AssetsToExport.Num() - NumFailed;
+	UE_LOG(LogJsonSerialization, Display, TEXT("Wrote %d files, %lld bytes in %.2fs (%.1f files/s, %.2f MB/s). Skipped %d unchanged, %d failed."),
+		NumWritten, NumBytes.load(), Seconds, NumWritten / Seconds, NumBytes.load() / Seconds / (1024.0 * 1024.0),
+		Assets.Num() - AssetsToExport.Num(), NumFailed.load());
+
+	return NumFailed > 0 ? 1 : 0;
+}
@@ -0,0 +1,32 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "JsonExportCommandlet.generated.h"
+
+/**
+ * Exports assets to json without opening the editor UI. Runs headless, e.g. on a Linux build machine:
+ *
+ * UnrealEditor-Cmd Project.uproject -run=JsonExport -Paths=/Game/Data+/Game/Items -Output=/tmp/Json -nullrhi -unattended
+ *
+ * -Paths=    '+'-separated package paths to search recursively. Defaults to /Game.
+ * -Classes=  '+'-separated class paths to export, e.g. /Script/Engine.DataAsset. Subclasses are included. Defaults to every class.
+ * -Output=   Output directory. Defaults to Saved/JsonExport.
+ * -BatchSize= Number of assets loaded, serialized and released at a time. Defaults to 256.
+ * -IncludeClasses Writes the Class/Properties envelope.
+ * -Full      Re-exports assets whose package and class are unchanged since the last run. Assets are also
+ *            re-exported when the last run used other options or an older output format. Use it after a build
+ *            that changes native class defaults, which the skip check can't see.
+ */
+UCLASS()
+class UJsonExportCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UJsonExportCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
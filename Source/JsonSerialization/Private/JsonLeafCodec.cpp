@@ -0,0 +1,231 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "JsonLeafCodec.h"
+
+#include "JsonTextWriter.h"
+#include "UObject/EnumProperty.h"
+#include "UObject/UnrealType.h"
+
+#include <type_traits>
+
+EJsonLeafType FJsonLeafCodec::Classify(const FProperty* Property)
+{
+	if (Property == nullptr || Property->ArrayDim != 1)
+	{
+		return EJsonLeafType::None;
+	}
+
+	if (Property->IsA<FBoolProperty>()) return EJsonLeafType::Bool;
+	if (Property->IsA<FEnumProperty>()) return EJsonLeafType::Enum;
+	if (const FByteProperty* ByteProperty = CastField<FByteProperty>(Property))
+	{
+		return ByteProperty->Enum ? EJsonLeafType::Enum : EJsonLeafType::UInt8;
+	}
+	if (Property->IsA<FInt8Property>()) return EJsonLeafType::Int8;
+	if (Property->IsA<FInt16Property>()) return EJsonLeafType::Int16;
+	if (Property->IsA<FIntProperty>()) return EJsonLeafType::Int32;
+	if (Property->IsA<FInt64Property>()) return EJsonLeafType::Int64;
+	if (Property->IsA<FUInt16Property>()) return EJsonLeafType::UInt16;
+	if (Property->IsA<FUInt32Property>()) return EJsonLeafType::UInt32;
+	if (Property->IsA<FUInt64Property>()) return EJsonLeafType::UInt64;
+	if (Property->IsA<FFloatProperty>()) return EJsonLeafType::Float;
+	if (Property->IsA<FDoubleProperty>()) return EJsonLeafType::Double;
+	if (Property->IsA<FNameProperty>()) return EJsonLeafType::Name;
+	if (Property->IsA<FStrProperty>()) return EJsonLeafType::String;
+
+	return EJsonLeafType::None;
+}
+
+static void GetEnumAndUnderlying(const FProperty* Property, const UEnum*& OutEnum, const FNumericProperty*& OutUnderlying)
+{
+	if (const FEnumProperty* EnumProperty = CastField<FEnumProperty>(Property))
+	{
+		OutEnum = EnumProperty->GetEnum();
+		OutUnderlying = EnumProperty->GetUnderlyingProperty();
+	}
+	else
+	{
+		const FByteProperty* ByteProperty = CastFieldChecked<FByteProperty>(Property);
+		OutEnum = ByteProperty->Enum;
+		OutUnderlying = ByteProperty;
+	}
+}
+
+// Casting a double the integer can't hold is undefined, so saturate first. The upper bound is one past Max, which
+// unlike Max itself is exact in a double for 64-bit types
+template<typename T>
+static T SaturateToInteger(double Number)
+{
+	constexpr double Lower = (double)TNumericLimits<T>::Min();
+	constexpr double Upper = (double)(TNumericLimits<T>::Max() / 2 + 1) * 2.0;
+	if (FMath::IsNaN(Number)) return 0;
+	if (Number <= Lower) return TNumericLimits<T>::Min();
+	if (Number >= Upper) return TNumericLimits<T>::Max();
+	return (T)Number;
+}
+
+template<typename T>
+static bool StoreNumber(double Number, void* ValueData)
+{
+	if constexpr (std::is_floating_point_v<T>)
+	{
+		*(T*)ValueData = (T)Number;
+	}
+	else
+	{
+		*(T*)ValueData = SaturateToInteger<T>(Number);
+	}
+	return true;
+}
+
+bool FJsonLeafCodec::ReadBool(const FProperty* Property, const void* ValueData)
+{
+	return static_cast<const FBoolProperty*>(Property)->GetPropertyValue(ValueData);
+}
+
+double FJsonLeafCodec::ReadNumber(EJsonLeafType Type, const void* ValueData)
+{
+	switch (Type)
+	{
+	case EJsonLeafType::Int8: return (double)*(const int8*)ValueData;
+	case EJsonLeafType::Int16: return (double)*(const int16*)ValueData;
+	case EJsonLeafType::Int32: return (double)*(const int32*)ValueData;
+	case EJsonLeafType::Int64: return (double)*(const int64*)ValueData;
+	case EJsonLeafType::UInt8: return (double)*(const uint8*)ValueData;
+	case EJsonLeafType::UInt16: return (double)*(const uint16*)ValueData;
+	case EJsonLeafType::UInt32: return (double)*(const uint32*)ValueData;
+	case EJsonLeafType::UInt64: return (double)*(const uint64*)ValueData;
+	// Widened to the double with the float's shortest digits, so text output doesn't show the float's binary error.
+	// FJsonObjectConverter widens exactly, so DOM numbers for floats differ from its output
+	case EJsonLeafType::Float: return FJsonTextWriter::WidenFloat(*(const float*)ValueData);
+	case EJsonLeafType::Double: return *(const double*)ValueData;
+	default:
+		checkNoEntry();
+		return 0.0;
+	}
+}
+
+FString FJsonLeafCodec::ReadString(EJsonLeafType Type, const FProperty* Property, const void* ValueData)
+{
+	switch (Type)
+	{
+	case EJsonLeafType::Name: return ((const FName*)ValueData)->ToString();
+	case EJsonLeafType::String: return *(const FString*)ValueData;
+	case EJsonLeafType::Enum:
+	{
+		// Authored names, like FJsonObjectConverter, so user defined enums keep their display names
+		const UEnum* Enum;
+		const FNumericProperty* Underlying;
+		GetEnumAndUnderlying(Property, Enum, Underlying);
+		return Enum->GetAuthoredNameStringByValue(Underlying->GetSignedIntPropertyValue(ValueData));
+	}
+	default:
+		checkNoEntry();
+		return FString();
+	}
+}
+
+TSharedPtr<FJsonValue> FJsonLeafCodec::Encode(EJsonLeafType Type, const FProperty* Property, const void* ValueData)
+{
+	switch (Type)
+	{
+	case EJsonLeafType::None:
+		return nullptr;
+	case EJsonLeafType::Bool:
+		return MakeShared<FJsonValueBoolean>(ReadBool(Property, ValueData));
+	case EJsonLeafType::Name:
+	case EJsonLeafType::String:
+	case EJsonLeafType::Enum:
+		return MakeShared<FJsonValueString>(ReadString(Type, Property, ValueData));
+	default:
+		return MakeShared<FJsonValueNumber>(ReadNumber(Type, ValueData));
+	}
+}
+
+bool FJsonLeafCodec::Decode(EJsonLeafType Type, const TSharedPtr<FJsonValue>& Value, const FProperty* Property, void* ValueData)
+{
+	if (!Value.IsValid()) return false;
+
+	switch (Value->Type)
+	{
+	case EJson::Boolean:
+		return DecodeBool(Type, Property, Value->AsBool(), ValueData);
+	case EJson::Number:
+		return DecodeNumber(Type, Property, Value->AsNumber(), ValueData);
+	case EJson::String:
+	{
+		FString String = Value->AsString();
+		if (Type == EJsonLeafType::String)
+		{
+			*(FString*)ValueData = MoveTemp(String);
+			return true;
+		}
+		return DecodeString(Type, Property, String, ValueData);
+	}
+	default:
+		return false;
+	}
+}
+
+bool FJsonLeafCodec::DecodeBool(EJsonLeafType Type, const FProperty* Property, bool bValue, void* ValueData)
+{
+	if (Type != EJsonLeafType::Bool) return false;
+
+	static_cast<const FBoolProperty*>(Property)->SetPropertyValue(ValueData, bValue);
+	return true;
+}
+
+bool FJsonLeafCodec::DecodeNumber(EJsonLeafType Type, const FProperty* Property, double Number, void* ValueData)
+{
+	switch (Type)
+	{
+	case EJsonLeafType::Int8: return StoreNumber<int8>(Number, ValueData);
+	case EJsonLeafType::Int16: return StoreNumber<int16>(Number, ValueData);
+	case EJsonLeafType::Int32: return StoreNumber<int32>(Number, ValueData);
+	case EJsonLeafType::Int64: return StoreNumber<int64>(Number, ValueData);
+	case EJsonLeafType::UInt8: return StoreNumber<uint8>(Number, ValueData);
+	case EJsonLeafType::UInt16: return StoreNumber<uint16>(Number, ValueData);
+	case EJsonLeafType::UInt32: return StoreNumber<uint32>(Number, ValueData);
+	case EJsonLeafType::UInt64: return StoreNumber<uint64>(Number, ValueData);
+	case EJsonLeafType::Float: return StoreNumber<float>(Number, ValueData);
+	case EJsonLeafType::Double: return StoreNumber<double>(Number, ValueData);
+	case EJsonLeafType::Enum:
+	{
+		const UEnum* Enum;
+		const FNumericProperty* Underlying;
+		GetEnumAndUnderlying(Property, Enum, Underlying);
+		Underlying->SetIntPropertyValue(ValueData, SaturateToInteger<int64>(Number));
+		return true;
+	}
+	default:
+		return false;
+	}
+}
+
+bool FJsonLeafCodec::DecodeString(EJsonLeafType Type, const FProperty* Property, FStringView String, void* ValueData)
+{
+	switch (Type)
+	{
+	case EJsonLeafType::Name:
+		*(FName*)ValueData = FName(String.Len(), String.GetData());
+		return true;
+	case EJsonLeafType::String:
+		*(FString*)ValueData = FString(String);
+		return true;
+	case EJsonLeafType::Enum:
+	{
+		const UEnum* Enum;
+		const FNumericProperty* Underlying;
+		GetEnumAndUnderlying(Property, Enum, Underlying);
+
+		// Names the plain lookup doesn't know, e.g. user defined enum display names, go to the converter
+		const int64 EnumValue = Enum->GetValueByNameString(FString(String));
+		if (EnumValue == INDEX_NONE) return false;
+
+		Underlying->SetIntPropertyValue(ValueData, EnumValue);
+		return true;
+	}
+	default:
+		return false;
+	}
+}
@@ -0,0 +1,72 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonValue.h"
+
+enum class EJsonLeafType : uint8
+{
+	None,
+	Bool,
+	Int8,
+	Int16,
+	Int32,
+	Int64,
+	UInt8,
+	UInt16,
+	UInt32,
+	UInt64,
+	Float,
+	Double,
+	Name,
+	String,
+	Enum,
+};
+
+/**
+ * Converts the common primitive property types to and from json values directly, without going through
+ * FJsonObjectConverter's generic dispatch and export text fallbacks. Output matches FJsonObjectConverter except for
+ * floats, which become the double with the float's shortest digits (0.1f gives 0.1, where the converter gives
+ * 0.100000001490116); both read back as the same float. Types it doesn't handle classify as None and are left to
+ * the converter.
+ */
+struct FJsonLeafCodec
+{
+	/** Classify once per property and pass the result to Encode/Decode. Static arrays are None. */
+	static EJsonLeafType Classify(const FProperty* Property);
+
+	static TSharedPtr<FJsonValue> Encode(EJsonLeafType Type, const FProperty* Property, const void* ValueData);
+
+	/** Writes the value straight to a TJsonWriter, for the streaming serializer, without allocating an FJsonValue. */
+	template<class WriterType>
+	static void Write(WriterType& Writer, EJsonLeafType Type, const FProperty* Property, const void* ValueData)
+	{
+		switch (Type)
+		{
+		case EJsonLeafType::Bool:
+			Writer.WriteValue(ReadBool(Property, ValueData));
+			break;
+		case EJsonLeafType::Name:
+		case EJsonLeafType::String:
+		case EJsonLeafType::Enum:
+			Writer.WriteValue(ReadString(Type, Property, ValueData));
+			break;
+		default:
+			Writer.WriteValue(ReadNumber(Type, ValueData));
+			break;
+		}
+	}
+
+	/** Returns false, leaving ValueData untouched, if Value isn't the json type this fast path expects. */
+	static bool Decode(EJsonLeafType Type, const TSharedPtr<FJsonValue>& Value, const FProperty* Property, void* ValueData);
+
+	/** Decode for values that aren't held in an FJsonValue, e.g. read from an FJsonTape, one per json type. */
+	static bool DecodeBool(EJsonLeafType Type, const FProperty* Property, bool bValue, void* ValueData);
+	static bool DecodeNumber(EJsonLeafType Type, const FProperty* Property, double Number, void* ValueData);
+	static bool DecodeString(EJsonLeafType Type, const FProperty* Property, FStringView String, void* ValueData);
+
+	static bool ReadBool(const FProperty* Property, const void* ValueData);
+	static double ReadNumber(EJsonLeafType Type, const void* ValueData);
+	static FString ReadString(EJsonLeafType Type, const FProperty* Property, const void* ValueData);
+};
@@ -0,0 +1,107 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "JsonMigrationRegistry.h"
+
+#include "JsonClassPlan.h"
+#include "JsonSerialization.h"
+#include "Misc/ScopeRWLock.h"
+#include "UObject/UnrealType.h"
+
+#include <atomic>
+
+struct FJsonRegisteredMigration
+{
+	FName Property;
+	FJsonClassPlan::FMigration Migration;
+};
+
+static FRWLock MigrationsLock;
+
+// By struct path, so registrations survive blueprint recompiles and reinstancing
+static TMap<FString, TArray<FJsonRegisteredMigration>> RegisteredMigrations;
+
+// Bumped under MigrationsLock on every change, before the plans are flushed
+static std::atomic<uint32> MigrationsGeneration{0};
+
+static void AddMigration(const UStruct* Struct, FName Property, FJsonClassPlan::FMigration&& Migration)
+{
+	check(Struct);
+
+	{
+		FWriteScopeLock WriteLock(MigrationsLock);
+		RegisteredMigrations.FindOrAdd(Struct->GetPathName()).Add({ Property, MoveTemp(Migration) });
+		++MigrationsGeneration;
+	}
+
+	// Plans already built don't know about the new migration
+	FJsonClassPlan::FlushAll();
+}
+
+void FJsonMigrationRegistry::AddRenamedProperty(const UStruct* Struct, const FString& OldKey, FName Property, FJsonValueConverter Converter)
+{
+	FJsonClassPlan::FMigration Migration;
+	Migration.OldKey = OldKey;
+	Migration.Converter = MoveTemp(Converter);
+	AddMigration(Struct, Property, MoveTemp(Migration));
+}
+
+void FJsonMigrationRegistry::AddRetypedProperty(const UStruct* Struct, FName Property, EJson OldType, FJsonValueConverter Converter)
+{
+	check(Converter);
+
+	FJsonClassPlan::FMigration Migration;
+	Migration.OldType = OldType;
+	Migration.Converter = MoveTemp(Converter);
+	AddMigration(Struct, Property, MoveTemp(Migration));
+}
+
+void FJsonMigrationRegistry::RemoveMigrations(const UStruct* Struct)
+{
+	check(Struct);
+
+	{
+		FWriteScopeLock WriteLock(MigrationsLock);
+		RegisteredMigrations.Remove(Struct->GetPathName());
+		++MigrationsGeneration;
+	}
+
+	FJsonClassPlan::FlushAll();
+}
+
+void FJsonMigrationRegistry::ResolveMigrations(FJsonClassPlan& Plan)
+{
+	FReadScopeLock ReadLock(MigrationsLock);
+	if (RegisteredMigrations.Num() == 0) return;
+
+	for (const UStruct* Struct = Plan.Struct.Get(); Struct != nullptr; Struct = Struct->GetSuperStruct())
+	{
+		const TArray<FJsonRegisteredMigration>* Registered = RegisteredMigrations.Find(Struct->GetPathName());
+		if (Registered == nullptr) continue;
+
+		for (const FJsonRegisteredMigration& Entry : *Registered)
+		{
+			const FString PropertyName = Entry.Property.ToString();
+			const int32 PropertyIndex = Plan.Properties.IndexOfByPredicate([&Entry, &PropertyName](const FProperty* Property)
+			{
+				return Property->GetFName() == Entry.Property || Property->GetAuthoredName() == PropertyName;
+			});
+
+			if (PropertyIndex == INDEX_NONE)
+			{
+				UE_LOG(LogJsonSerialization, Warning, TEXT("Json migration for %s.%s ignored: the property doesn't exist or isn't serialized"), *Struct->GetName(), *PropertyName);
+				continue;
+			}
+
+			if (Plan.Migrations.Num() == 0)
+			{
+				Plan.Migrations.SetNum(Plan.Properties.Num());
+			}
+			Plan.Migrations[PropertyIndex].Add(Entry.Migration);
+		}
+	}
+}
+
+uint32 FJsonMigrationRegistry::GetGeneration()
+{
+	return MigrationsGeneration.load();
+}
@@ -2,792 +2,1571 @@
 
 #include "JsonSerialization.h"
 
+#include "JsonClassPlan.h"
+#include "JsonLeafCodec.h"
+#include "JsonTape.h"
+#include "JsonTextWriter.h"
 #include "JsonObjectConverter.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonWriter.h"
 #include "UObject/UnrealType.h"
+#include "UObject/UObjectGlobals.h"
 #include "InstancedStruct.h"
 
 #define LOCTEXT_NAMESPACE "FJsonSerializationModule"
 
+DEFINE_LOG_CATEGORY(LogJsonSerialization);
+
+DECLARE_STATS_GROUP(TEXT("JsonSerialization"), STATGROUP_JsonSerialization, STATCAT_Advanced);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Reserved container slots"), STAT_JsonReservedSlots, STATGROUP_JsonSerialization);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Container regrowths"), STAT_JsonContainerRegrowths, STATGROUP_JsonSerialization);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Output buffer regrowths"), STAT_JsonOutputRegrowths, STATGROUP_JsonSerialization);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Output characters"), STAT_JsonOutputChars, STATGROUP_JsonSerialization);
+
+const FName FJsonSerializerFields::ObjectClassField = FName("Class");
+const FName FJsonSerializerFields::ObjectNameField = FName("Name");
+const FName FJsonSerializerFields::ObjectPropertiesField = FName("Properties");
+const FName FJsonSerializerFields::ObjectSchemaField = FName("Schema");
+const FName FJsonSerializerFields::SchemasField = FName("Schemas");
+
 void FJsonSerializationModule::StartupModule()
 {
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
+#if WITH_EDITOR
+	// Recompiled blueprints regenerate their properties, so cached class plans must be rebuilt
+	ObjectsReplacedHandle = FCoreUObjectDelegates::OnObjectsReplaced.AddLambda([](const TMap<UObject*, UObject*>&)
+	{
+		FJsonClassPlan::FlushAll();
+	});
+#endif
 }
 
 void FJsonSerializationModule::ShutdownModule()
 {
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
+#if WITH_EDITOR
+	FCoreUObjectDelegates::OnObjectsReplaced.Remove(ObjectsReplacedHandle);
+#endif
+	FJsonClassPlan::FlushAll();
 }
 
-struct FPropertyTest {
-	FPropertyTest(FProperty* Property) {
-		Raw = Property;
-		AsArray = CastField< FArrayProperty>(Property);
-		AsSet = CastField< FSetProperty>(Property);
-		AsMap = CastField< FMapProperty>(Property);
-		AsStruct = CastField< FStructProperty>(Property);
-		AsObject = CastField< FObjectProperty>(Property);
-	};
-
-	FProperty* Raw;
-	FArrayProperty* AsArray;
-	FSetProperty* AsSet;
-	FMapProperty* AsMap;
-	FStructProperty* AsStruct;
-	FObjectProperty* AsObject;
+struct FJsonSerializeContext {
+	TSet<const UObject*> TraversedObjects;
+	bool bIncludeObjectClasses = false;
+	bool bChangedPropertiesOnly = false;
+	bool bPositionalProperties = false;
+
+	// Fingerprint -> property names, written once at the document root in positional mode
+	TSharedPtr<FJsonObject> Schemas;
+
+	// Estimated DOM size and its budget. MaxDomBytes <= 0 disables tracking
+	int64 MaxDomBytes = 0;
+	int64 DomBytes = 0;
+	bool bBudgetExceeded = false;
+	FString ExceededPropertyPath;
+
+	// Field names and container indices leading to the value being serialized, only kept while a budget is set
+	TArray<TPair<const FString*, int32>> PropertyPath;
+
+	// Plans of the classes written by the streaming serializer in positional mode, by fingerprint
+	TMap<FString, TSharedRef<const FJsonClassPlan>> StreamedSchemas;
 };
 
-static void SerializePropertyAsJsonObjectField(const void* Data, const UObject* Outer, TSharedPtr<FJsonObject> OuterObject, FProperty* Property, TSet<const UObject*>& TraversedObjects, bool bIncludeObjectClasses, bool bChangedPropertiesOnly);
-static void SerializeStructPropertyAsJsonObjectField(const void* InnerPropData, const UObject* Outer, FStructProperty* StructProperty, TSharedPtr<FJsonObject> StructObject, TSet<const UObject*>& TraversedObjects, bool bIncludeObjectClasses, bool bChangedPropertiesOnly);
-static TArray<TSharedPtr<FJsonValue>> SerializeArrayPropertyAsJsonArray(const void* Data, const UObject* Outer, FArrayProperty* Property, TSet<const UObject*>& TraversedObjects, bool bIncludeObjectClasses, bool bChangedPropertiesOnly);
-static TArray<TSharedPtr<FJsonValue>> SerializeSetPropertyAsJsonArray(const void* Data, const UObject* Outer, FSetProperty* Property, TSet<const UObject*>& TraversedObjects, bool bIncludeObjectClasses, bool bChangedPropertiesOnly);
-static TArray<TSharedPtr<FJsonValue>> SerializeMapPropertyAsJsonArray(const void* Data, const UObject* Outer, FMapProperty* Property, TSet<const UObject*>& TraversedObjects, bool bIncludeObjectClasses, bool bChangedPropertiesOnly);
+struct FJsonDeserializeContext {
+	bool bIncludeObjectClasses = false;
+
+	// The writer's schema table, used to read positional bodies whose fingerprint doesn't match the local class
+	TSharedPtr<FJsonObject> Schemas;
+
+	// The parsed document and the index of its schema table when reading straight from a tape
+	const FJsonTape* Tape = nullptr;
+	int32 TapeSchemas = INDEX_NONE;
+};
+
+// Rough DOM costs: a json value with its shared reference controller, an object's field map entry, an array slot
+static const int64 JsonValueBytes = sizeof(FJsonValueObject) + 16;
+static const int64 JsonObjectBytes = JsonValueBytes + sizeof(FJsonObject) + 16;
+static const int64 JsonFieldBytes = sizeof(TPair<FString, TSharedPtr<FJsonValue>>) + 16;
+static const int64 JsonSlotBytes = sizeof(TSharedPtr<FJsonValue>);
+
+struct FJsonPropertyPathScope {
+	FJsonPropertyPathScope(FJsonSerializeContext& InContext, const FString* FieldName, int32 Index = INDEX_NONE)
+		: Context(InContext)
+		, bTracked(InContext.MaxDomBytes > 0)
+	{
+		if (bTracked) Context.PropertyPath.Emplace(FieldName, Index);
+	}
+
+	~FJsonPropertyPathScope()
+	{
+		if (bTracked) Context.PropertyPath.Pop();
+	}
+
+	FJsonSerializeContext& Context;
+	bool bTracked;
+};
 
-static void SerializeStructPropertyAsJsonObjectField(const void* InnerPropData, const UObject* Outer, FStructProperty* StructProperty, TSharedPtr<FJsonObject> StructObject, TSet<const UObject*>& TraversedObjects, bool bIncludeObjectClasses, bool bChangedPropertiesOnly)
+static FString BuildPropertyPath(const FJsonSerializeContext& Context)
 {
-	const uint8* StructPropData = StructProperty->ContainerPtrToValuePtr<uint8>(InnerPropData);
-	if (StructProperty->Struct == TBaseStructure<FInstancedStruct>::Get())
+	FString Path;
+	for (const TPair<const FString*, int32>& Segment : Context.PropertyPath)
 	{
-		const FInstancedStruct& InstancedStruct = *(FInstancedStruct*)StructPropData;
-		for (TFieldIterator<FProperty> PropertyItr(InstancedStruct.GetScriptStruct()); PropertyItr; ++PropertyItr)
-		{
-			SerializePropertyAsJsonObjectField(InstancedStruct.GetMemory(), Outer, StructObject, *PropertyItr, TraversedObjects, bIncludeObjectClasses, bChangedPropertiesOnly);
+		if (Segment.Key) {
+			if (!Path.IsEmpty()) Path += TEXT('.');
+			Path += *Segment.Key;
 		}
+		else {
+			Path += FString::Printf(TEXT("[%d]"), Segment.Value);
+		}
+	}
+	return Path;
+}
+
+// Adds to the estimated DOM size, returns false once the budget is exceeded
+static bool ChargeDomBytes(FJsonSerializeContext& Context, int64 Bytes)
+{
+	if (Context.MaxDomBytes <= 0) return true;
+	if (Context.bBudgetExceeded) return false;
+
+	Context.DomBytes += Bytes;
+	if (Context.DomBytes > Context.MaxDomBytes) {
+		Context.bBudgetExceeded = true;
+		Context.ExceededPropertyPath = BuildPropertyPath(Context);
+		return false;
+	}
+	return true;
+}
+
+static int64 EstimateLeafBytes(const FProperty* Property, const void* ValueData)
+{
+	if (const FStrProperty* StrProp = CastField<FStrProperty>(Property)) {
+		return JsonValueBytes + StrProp->GetPropertyValue(ValueData).Len() * sizeof(TCHAR);
+	}
+	if (const FTextProperty* TextProp = CastField<FTextProperty>(Property)) {
+		return JsonValueBytes + TextProp->GetPropertyValue(ValueData).ToString().Len() * sizeof(TCHAR);
+	}
+	if (Property->IsA<FNameProperty>() || Property->IsA<FEnumProperty>()) {
+		return JsonValueBytes + 32 * sizeof(TCHAR);
+	}
+	return JsonValueBytes;
+}
+
+// Containers are sized to their final element count before they are filled. Returns the allocation size to hand to
+// CountJsonContainerRegrowth once the container is filled
+static SIZE_T ReserveJsonArray(TArray<TSharedPtr<FJsonValue>>& Array, int32 Num)
+{
+	Array.Reserve(Num);
+	INC_DWORD_STAT_BY(STAT_JsonReservedSlots, Num);
+	return Array.GetAllocatedSize();
+}
+
+static SIZE_T ReserveJsonObject(FJsonObject& Object, int32 Num)
+{
+	Object.Values.Reserve(Num);
+	INC_DWORD_STAT_BY(STAT_JsonReservedSlots, Num);
+	return Object.Values.GetAllocatedSize();
+}
+
+// A container whose allocation changed while it was filled outgrew its reservation and was reallocated
+static void CountJsonContainerRegrowth(SIZE_T ReservedSize, SIZE_T FilledSize)
+{
+	if (FilledSize != ReservedSize)
+	{
+		INC_DWORD_STAT(STAT_JsonContainerRegrowths);
+	}
+}
+
+// Maps keyed by strings, names, enums or integers are written as a json object keyed by the stringified key
+static bool IsStringLikeMapKey(const FProperty* KeyProp)
+{
+	if (KeyProp->IsA<FStrProperty>() || KeyProp->IsA<FNameProperty>() || KeyProp->IsA<FEnumProperty>())
+	{
+		return true;
+	}
+
+	const FNumericProperty* NumericProp = CastField<FNumericProperty>(KeyProp);
+	return NumericProp && NumericProp->IsInteger();
+}
+
+static FString MapKeyToString(const FProperty* KeyProp, const void* KeyData)
+{
+	if (const FStrProperty* StrProp = CastField<FStrProperty>(KeyProp))
+	{
+		return StrProp->GetPropertyValue(KeyData);
+	}
+	if (const FNameProperty* NameProp = CastField<FNameProperty>(KeyProp))
+	{
+		return NameProp->GetPropertyValue(KeyData).ToString();
+	}
+
+	const UEnum* Enum = nullptr;
+	const FNumericProperty* NumericProp = nullptr;
+	if (const FEnumProperty* EnumProp = CastField<FEnumProperty>(KeyProp))
+	{
+		Enum = EnumProp->GetEnum();
+		NumericProp = EnumProp->GetUnderlyingProperty();
 	}
 	else
 	{
-		for (TFieldIterator<FProperty> PropertyItr(StructProperty->Struct); PropertyItr; ++PropertyItr)
+		NumericProp = CastFieldChecked<FNumericProperty>(KeyProp);
+		Enum = NumericProp->GetIntPropertyEnum();
+	}
+
+	if (Enum)
+	{
+		// Authored names, the same as enum values get
+		FString Name = Enum->GetAuthoredNameStringByValue(NumericProp->GetSignedIntPropertyValue(KeyData));
+		if (!Name.IsEmpty())
 		{
-			SerializePropertyAsJsonObjectField((void*)StructPropData, Outer, StructObject, *PropertyItr, TraversedObjects, bIncludeObjectClasses, bChangedPropertiesOnly);
+			return Name;
 		}
 	}
+	return NumericProp->GetNumericPropertyValueToString(KeyData);
 }
 
-static TArray<TSharedPtr<FJsonValue>> SerializeArrayPropertyAsJsonArray(const void* Data, const UObject* Outer, FArrayProperty* Property, TSet<const UObject*>& TraversedObjects, bool bIncludeObjectClasses, bool bChangedPropertiesOnly)
+static void MapKeyFromString(const FProperty* KeyProp, void* KeyData, const FString& KeyString)
 {
-	const uint8* PropData = Property->ContainerPtrToValuePtr<uint8>(Data);
-	FScriptArrayHelper Helper(Property, PropData);
-	TArray<TSharedPtr<FJsonValue>> ValueArray;
+	if (const FStrProperty* StrProp = CastField<FStrProperty>(KeyProp))
+	{
+		StrProp->SetPropertyValue(KeyData, KeyString);
+		return;
+	}
+	if (const FNameProperty* NameProp = CastField<FNameProperty>(KeyProp))
+	{
+		NameProp->SetPropertyValue(KeyData, FName(*KeyString));
+		return;
+	}
 
-	FPropertyTest TestProp = FPropertyTest(Property->Inner);
+	const UEnum* Enum = nullptr;
+	const FNumericProperty* NumericProp = nullptr;
+	if (const FEnumProperty* EnumProp = CastField<FEnumProperty>(KeyProp))
+	{
+		Enum = EnumProp->GetEnum();
+		NumericProp = EnumProp->GetUnderlyingProperty();
+	}
+	else
+	{
+		NumericProp = CastFieldChecked<FNumericProperty>(KeyProp);
+		Enum = NumericProp->GetIntPropertyEnum();
+	}
 
-	for (int32 i = 0, n = Helper.Num(); i < n; ++i)
+	if (Enum)
 	{
-		const uint8* InnerPropData = Helper.GetRawPtr(i);
-		if (TestProp.AsArray) // Array
-		{
-			TArray<TSharedPtr<FJsonValue>> InnerArray = SerializeArrayPropertyAsJsonArray(InnerPropData, Outer, TestProp.AsArray, TraversedObjects, bIncludeObjectClasses, bChangedPropertiesOnly);
-			ValueArray.Emplace(new FJsonValueArray(InnerArray));
-		}
-		if (TestProp.AsSet) // Set
-		{
-			TArray<TSharedPtr<FJsonValue>> InnerArray = SerializeSetPropertyAsJsonArray(InnerPropData, Outer, TestProp.AsSet, TraversedObjects, bIncludeObjectClasses, bChangedPropertiesOnly);
-			ValueArray.Emplace(new FJsonValueArray(InnerArray));
-		}
-		if (TestProp.AsMap) // Map
+		int64 Value = Enum->GetValueByNameString(KeyString);
+		if (Value == INDEX_NONE)
 		{
-			TArray<TSharedPtr<FJsonValue>> InnerArray = SerializeMapPropertyAsJsonArray(InnerPropData, Outer, TestProp.AsMap, TraversedObjects, bIncludeObjectClasses, bChangedPropertiesOnly);
-			ValueArray.Emplace(new FJsonValueArray(InnerArray));
-		}
-		else if (TestProp.AsStruct) // Struct
-		{
-			TSharedPtr<FJsonObject> StructObject = MakeShareable(new FJsonObject);
-			SerializeStructPropertyAsJsonObjectField(InnerPropData, Outer, TestProp.AsStruct, StructObject, TraversedObjects, bIncludeObjectClasses, bChangedPropertiesOnly);
-			ValueArray.Emplace(new FJsonValueObject(StructObject));
-		}
-		else if (TestProp.AsObject) // Object
-		{
-			const UObject* SubObject = TestProp.AsObject->GetObjectPropertyValue_InContainer(InnerPropData);
-			if (SubObject->IsValidLowLevel() && SubObject->GetOuter() == Outer && !TraversedObjects.Contains(SubObject))
+			// Keys are written with authored names, which differ from the plain names for user defined enums
+			for (int32 i = 0; i < Enum->NumEnums(); ++i)
 			{
-				TraversedObjects.Add(SubObject);
-				TSharedPtr<FJsonObject> JsonSubObject = MakeShared<FJsonObject>();
-				TSharedPtr<FJsonObject> JsonSubObjectProperties = JsonSubObject;
-
-				if (bIncludeObjectClasses) {
-					JsonSubObjectProperties = MakeShared<FJsonObject>();
-					JsonSubObject->SetStringField(FJsonSerializerFields::ObjectClassField.ToString(), SubObject->GetClass()->GetPathName());
-					JsonSubObject->SetObjectField(FJsonSerializerFields::ObjectPropertiesField.ToString(), JsonSubObjectProperties);
-				}
-
-				for (TFieldIterator<FProperty> PropertyItr(SubObject->GetClass()); PropertyItr; ++PropertyItr)
+				if (Enum->GetAuthoredNameStringByIndex(i) == KeyString)
 				{
-					SerializePropertyAsJsonObjectField(SubObject, SubObject, JsonSubObjectProperties, *PropertyItr, TraversedObjects, bIncludeObjectClasses, bChangedPropertiesOnly);
+					Value = Enum->GetValueByIndex(i);
+					break;
 				}
-				ValueArray.Emplace(new FJsonValueObject(JsonSubObject));
-			}
-			else {
-				ValueArray.Emplace(new FJsonValueString(SubObject->GetPathName()));
 			}
 		}
-		else
+		if (Value != INDEX_NONE)
 		{
-			TSharedPtr<FJsonValue> JsonValue;
-			const uint8* InnerInnerPropData = Property->Inner->ContainerPtrToValuePtr<uint8>(InnerPropData);
-			ValueArray.Emplace(FJsonObjectConverter::UPropertyToJsonValue(Property->Inner, InnerInnerPropData));
+			NumericProp->SetIntPropertyValue(KeyData, Value);
+			return;
 		}
 	}
-	return ValueArray;
+	NumericProp->SetNumericPropertyValueFromString(KeyData, *KeyString);
 }
 
-static TArray<TSharedPtr<FJsonValue>> SerializeSetPropertyAsJsonArray(const void* Data, const UObject* Outer, FSetProperty* Property, TSet<const UObject*>& TraversedObjects, bool bIncludeObjectClasses, bool bChangedPropertiesOnly)
+static TSharedPtr<FJsonValue> SerializePropertyAsJsonValue(const void* ValueData, const UObject* Outer, const FPropertyTest& TestProp, FJsonSerializeContext& Context);
+static void SerializePropertyAsJsonObjectField(const void* Data, const UObject* Outer, TSharedPtr<FJsonObject> OuterObject, const FPropertyTest& TestProp, const FString& FieldName, FJsonSerializeContext& Context);
+static TSharedPtr<FJsonObject> SerializeStructPropertyAsJsonObject(const void* StructData, const UObject* Outer, FStructProperty* StructProperty, FJsonSerializeContext& Context);
+static TSharedPtr<FJsonValue> SerializeObjectPropertyAsJsonValue(const UObject* SubObject, const UObject* Outer, FJsonSerializeContext& Context);
+static TSharedPtr<FJsonObject> SerializeObjectAsJsonObject(const UObject* Object, FJsonSerializeContext& Context);
+static TArray<TSharedPtr<FJsonValue>> SerializeArrayPropertyAsJsonArray(const void* ValueData, const UObject* Outer, FArrayProperty* Property, FJsonSerializeContext& Context);
+static TArray<TSharedPtr<FJsonValue>> SerializeSetPropertyAsJsonArray(const void* ValueData, const UObject* Outer, FSetProperty* Property, FJsonSerializeContext& Context);
+static TArray<TSharedPtr<FJsonValue>> SerializeMapPropertyAsJsonArray(const void* ValueData, const UObject* Outer, FMapProperty* Property, FJsonSerializeContext& Context);
+static TSharedPtr<FJsonObject> SerializeMapPropertyAsJsonObject(const void* ValueData, const UObject* Outer, FMapProperty* Property, FJsonSerializeContext& Context);
+
+static TSharedPtr<FJsonObject> SerializeStructPropertyAsJsonObject(const void* StructData, const UObject* Outer, FStructProperty* StructProperty, FJsonSerializeContext& Context)
 {
-	const uint8* PropData = Property->ContainerPtrToValuePtr<uint8>(Data);
-	FScriptSetHelper Helper(Property, PropData);
-	TArray<TSharedPtr<FJsonValue>> ValueArray;
+	const UStruct* Struct = StructProperty->Struct;
+	if (Struct == TBaseStructure<FInstancedStruct>::Get())
+	{
+		const FInstancedStruct& InstancedStruct = *(const FInstancedStruct*)StructData;
+		Struct = InstancedStruct.GetScriptStruct();
+		StructData = InstancedStruct.GetMemory();
+	}
 
-	FPropertyTest TestProp = FPropertyTest(Property->ElementProp);
+	TSharedPtr<FJsonObject> StructObject = MakeShared<FJsonObject>();
+	if (Struct == nullptr || !ChargeDomBytes(Context, JsonObjectBytes))
+	{
+		return StructObject;
+	}
 
-	for (FScriptSetHelper::FIterator Iter = Helper.CreateIterator(); Iter; Iter++)
+	TSharedRef<const FJsonClassPlan> Plan = FJsonClassPlan::Get(Struct);
+	const SIZE_T ReservedSize = ReserveJsonObject(*StructObject, Plan->Properties.Num());
+	for (int32 i = 0; i < Plan->Properties.Num() && !Context.bBudgetExceeded; ++i)
 	{
-		const uint8* InnerPropData = Helper.GetElementPtr(*Iter);
-		if (TestProp.AsArray) // Array
-		{
-			TArray<TSharedPtr<FJsonValue>> InnerArray = SerializeArrayPropertyAsJsonArray(InnerPropData, Outer, TestProp.AsArray, TraversedObjects, bIncludeObjectClasses, bChangedPropertiesOnly);
-			ValueArray.Emplace(new FJsonValueArray(InnerArray));
-		}
-		if (TestProp.AsSet) // Set
-		{
-			TArray<TSharedPtr<FJsonValue>> InnerArray = SerializeSetPropertyAsJsonArray(InnerPropData, Outer, TestProp.AsSet, TraversedObjects, bIncludeObjectClasses, bChangedPropertiesOnly);
-			ValueArray.Emplace(new FJsonValueArray(InnerArray));
-		}
-		if (TestProp.AsMap) // Map
-		{
-			TArray<TSharedPtr<FJsonValue>> InnerArray = SerializeMapPropertyAsJsonArray(InnerPropData, Outer, TestProp.AsMap, TraversedObjects, bIncludeObjectClasses, bChangedPropertiesOnly);
-			ValueArray.Emplace(new FJsonValueArray(InnerArray));
-		}
-		else if (TestProp.AsStruct) // Struct
+		SerializePropertyAsJsonObjectField(StructData, Outer, StructObject, Plan->PropertyTests[i], Plan->PropertyNames[i], Context);
+	}
+	CountJsonContainerRegrowth(ReservedSize, StructObject->Values.GetAllocatedSize());
+	return StructObject;
+}
+
+static TSharedPtr<FJsonValue> SerializeObjectPropertyAsJsonValue(const UObject* SubObject, const UObject* Outer, FJsonSerializeContext& Context)
+{
+	if (SubObject->IsValidLowLevel() && SubObject->GetOuter() == Outer && !Context.TraversedObjects.Contains(SubObject))
+	{
+		Context.TraversedObjects.Add(SubObject);
+		return MakeShared<FJsonValueObject>(SerializeObjectAsJsonObject(SubObject, Context));
+	}
+
+	FString Path = SubObject->GetPathName();
+	if (!ChargeDomBytes(Context, JsonValueBytes + Path.Len() * sizeof(TCHAR))) return nullptr;
+	return MakeShared<FJsonValueString>(MoveTemp(Path));
+}
+
+static TSharedPtr<FJsonObject> SerializeObjectAsJsonObject(const UObject* Object, FJsonSerializeContext& Context)
+{
+	TSharedRef<const FJsonClassPlan> Plan = FJsonClassPlan::Get(Object->GetClass());
+	TSharedPtr<FJsonObject> JsonObject = MakeShared<FJsonObject>();
+
+	if (!ChargeDomBytes(Context, JsonObjectBytes * 2))
+	{
+		return JsonObject;
+	}
+
+	if (Context.bPositionalProperties)
+	{
+		TArray<TSharedPtr<FJsonValue>> Values;
+		if (!ChargeDomBytes(Context, Plan->Properties.Num() * JsonSlotBytes)) return JsonObject;
+		const SIZE_T ReservedSize = ReserveJsonArray(Values, Plan->Properties.Num());
+		for (int32 i = 0; i < Plan->Properties.Num() && !Context.bBudgetExceeded; ++i)
 		{
-			TSharedPtr<FJsonObject> StructObject = MakeShareable(new FJsonObject);
-			SerializeStructPropertyAsJsonObjectField(InnerPropData, Outer, TestProp.AsStruct, StructObject, TraversedObjects, bIncludeObjectClasses, bChangedPropertiesOnly);
-			ValueArray.Emplace(new FJsonValueObject(StructObject));
+			FJsonPropertyPathScope PathScope(Context, &Plan->PropertyNames[i]);
+			const FPropertyTest& TestProp = Plan->PropertyTests[i];
+			TSharedPtr<FJsonValue> Value = SerializePropertyAsJsonValue(TestProp.Raw->ContainerPtrToValuePtr<void>(Object), Object, TestProp, Context);
+			Values.Emplace(Value.IsValid() ? Value : MakeShared<FJsonValueNull>());
 		}
-		else if (TestProp.AsObject) // Object
+		CountJsonContainerRegrowth(ReservedSize, Values.GetAllocatedSize());
+
+		if (!Context.Schemas->HasField(Plan->Fingerprint))
 		{
-			const UObject* SubObject = TestProp.AsObject->GetObjectPropertyValue_InContainer(InnerPropData);
-			if (SubObject->IsValidLowLevel() && SubObject->GetOuter() == Outer && !TraversedObjects.Contains(SubObject))
+			TArray<TSharedPtr<FJsonValue>> Names;
+			ReserveJsonArray(Names, Plan->PropertyNames.Num());
+			for (const FString& Name : Plan->PropertyNames)
 			{
-				TraversedObjects.Add(SubObject);
-				TSharedPtr<FJsonObject> JsonSubObject = MakeShared<FJsonObject>();
-				TSharedPtr<FJsonObject> JsonSubObjectProperties = JsonSubObject;
-
-				if (bIncludeObjectClasses) {
-					JsonSubObjectProperties = MakeShared<FJsonObject>();
-					JsonSubObject->SetStringField(FJsonSerializerFields::ObjectClassField.ToString(), SubObject->GetClass()->GetPathName());
-					JsonSubObject->SetObjectField(FJsonSerializerFields::ObjectPropertiesField.ToString(), JsonSubObjectProperties);
-				}
-
-				for (TFieldIterator<FProperty> PropertyItr(SubObject->GetClass()); PropertyItr; ++PropertyItr)
-				{
-					SerializePropertyAsJsonObjectField(SubObject, SubObject, JsonSubObjectProperties, *PropertyItr, TraversedObjects, bIncludeObjectClasses, bChangedPropertiesOnly);
-				}
-				ValueArray.Emplace(new FJsonValueObject(JsonSubObject));
+				Names.Emplace(MakeShared<FJsonValueString>(Name));
 			}
-			else {
-				ValueArray.Emplace(new FJsonValueString(SubObject->GetPathName()));
-			}
-		}
-		else
-		{
-			TSharedPtr<FJsonValue> JsonValue;
-			const uint8* InnerInnerPropData = TestProp.Raw->ContainerPtrToValuePtr<uint8>(InnerPropData);
-			ValueArray.Emplace(FJsonObjectConverter::UPropertyToJsonValue(TestProp.Raw, InnerInnerPropData));
+			Context.Schemas->SetArrayField(Plan->Fingerprint, Names);
 		}
+
+		ReserveJsonObject(*JsonObject, 4);
+		JsonObject->SetStringField(FJsonSerializerFields::ObjectClassField.ToString(), Object->GetClass()->GetPathName());
+		JsonObject->SetStringField(FJsonSerializerFields::ObjectSchemaField.ToString(), Plan->Fingerprint);
+		JsonObject->SetArrayField(FJsonSerializerFields::ObjectPropertiesField.ToString(), Values);
+		return JsonObject;
+	}
+
+	TSharedPtr<FJsonObject> JsonObjectProperties = JsonObject;
+	if (Context.bIncludeObjectClasses) {
+		JsonObjectProperties = MakeShared<FJsonObject>();
+		ReserveJsonObject(*JsonObject, 2);
+		JsonObject->SetStringField(FJsonSerializerFields::ObjectClassField.ToString(), Object->GetClass()->GetPathName());
+		JsonObject->SetObjectField(FJsonSerializerFields::ObjectPropertiesField.ToString(), JsonObjectProperties);
+	}
+	const SIZE_T ReservedSize = ReserveJsonObject(*JsonObjectProperties, Plan->Properties.Num());
+
+	for (int32 i = 0; i < Plan->Properties.Num() && !Context.bBudgetExceeded; ++i)
+	{
+		SerializePropertyAsJsonObjectField(Object, Object, JsonObjectProperties, Plan->PropertyTests[i], Plan->PropertyNames[i], Context);
 	}
+	CountJsonContainerRegrowth(ReservedSize, JsonObjectProperties->Values.GetAllocatedSize());
+	return JsonObject;
+}
+
+static TArray<TSharedPtr<FJsonValue>> SerializeArrayPropertyAsJsonArray(const void* ValueData, const UObject* Outer, FArrayProperty* Property, FJsonSerializeContext& Context)
+{
+	FScriptArrayHelper Helper(Property, ValueData);
+	TArray<TSharedPtr<FJsonValue>> ValueArray;
+
+	if (!ChargeDomBytes(Context, JsonValueBytes + Helper.Num() * JsonSlotBytes)) return ValueArray;
+	const SIZE_T ReservedSize = ReserveJsonArray(ValueArray, Helper.Num());
+
+	FPropertyTest TestProp = FPropertyTest(Property->Inner);
+
+	for (int32 i = 0, n = Helper.Num(); i < n && !Context.bBudgetExceeded; ++i)
+	{
+		FJsonPropertyPathScope PathScope(Context, nullptr, i);
+		ValueArray.Emplace(SerializePropertyAsJsonValue(Helper.GetRawPtr(i), Outer, TestProp, Context));
+	}
+	CountJsonContainerRegrowth(ReservedSize, ValueArray.GetAllocatedSize());
+	return ValueArray;
+}
+
+static TArray<TSharedPtr<FJsonValue>> SerializeSetPropertyAsJsonArray(const void* ValueData, const UObject* Outer, FSetProperty* Property, FJsonSerializeContext& Context)
+{
+	FScriptSetHelper Helper(Property, ValueData);
+	TArray<TSharedPtr<FJsonValue>> ValueArray;
+
+	if (!ChargeDomBytes(Context, JsonValueBytes + Helper.Num() * JsonSlotBytes)) return ValueArray;
+	const SIZE_T ReservedSize = ReserveJsonArray(ValueArray, Helper.Num());
+
+	FPropertyTest TestProp = FPropertyTest(Property->ElementProp);
+
+	int32 Index = 0;
+	for (FScriptSetHelper::FIterator Iter = Helper.CreateIterator(); Iter && !Context.bBudgetExceeded; Iter++, Index++)
+	{
+		FJsonPropertyPathScope PathScope(Context, nullptr, Index);
+		ValueArray.Emplace(SerializePropertyAsJsonValue(Helper.GetElementPtr(*Iter), Outer, TestProp, Context));
+	}
+	CountJsonContainerRegrowth(ReservedSize, ValueArray.GetAllocatedSize());
 	return ValueArray;
 }
 
 
-static TArray<TSharedPtr<FJsonValue>> SerializeMapPropertyAsJsonArray(const void* Data, const UObject* Outer, FMapProperty* Property, TSet<const UObject*>& TraversedObjects, bool bIncludeObjectClasses, bool bChangedPropertiesOnly) {
-	
-	const uint8* PropData = Property->ContainerPtrToValuePtr<uint8>(Data);
-	FScriptMapHelper Helper(Property, PropData);
+static TArray<TSharedPtr<FJsonValue>> SerializeMapPropertyAsJsonArray(const void* ValueData, const UObject* Outer, FMapProperty* Property, FJsonSerializeContext& Context) {
+
+	FScriptMapHelper Helper(Property, ValueData);
 	TArray<TSharedPtr<FJsonValue>> ValueArray;
 
+	// Each entry is an object holding two fields
+	if (!ChargeDomBytes(Context, JsonValueBytes + Helper.Num() * (JsonSlotBytes + JsonObjectBytes + 2 * JsonFieldBytes))) return ValueArray;
+	const SIZE_T ReservedSize = ReserveJsonArray(ValueArray, Helper.Num());
+
 	FPropertyTest TestKey = FPropertyTest(Helper.KeyProp);
 	FPropertyTest TestValue = FPropertyTest(Helper.ValueProp);
 
-	for (FScriptMapHelper::FIterator Iter = Helper.CreateIterator(); Iter; Iter++) {
+	int32 Index = 0;
+	for (FScriptMapHelper::FIterator Iter = Helper.CreateIterator(); Iter && !Context.bBudgetExceeded; Iter++, Index++) {
+		const uint8* KeyData = Helper.GetKeyPtr(*Iter);
+		const uint8* ValData = Helper.GetValuePtr(*Iter);
+
+		if (KeyData == nullptr || ValData == nullptr) continue;
+
+		FJsonPropertyPathScope PathScope(Context, nullptr, Index);
 		TSharedPtr<FJsonObject> KeyVal = MakeShared< FJsonObject>();
+		KeyVal->Values.Reserve(2);
+		KeyVal->SetField("Key", SerializePropertyAsJsonValue(KeyData, Outer, TestKey, Context));
+		KeyVal->SetField("Value", SerializePropertyAsJsonValue(ValData, Outer, TestValue, Context));
+
+		ValueArray.Emplace(new FJsonValueObject(KeyVal));
+	}
+	CountJsonContainerRegrowth(ReservedSize, ValueArray.GetAllocatedSize());
+
+	return ValueArray;
+}
+
+static TSharedPtr<FJsonObject> SerializeMapPropertyAsJsonObject(const void* ValueData, const UObject* Outer, FMapProperty* Property, FJsonSerializeContext& Context)
+{
+	FScriptMapHelper Helper(Property, ValueData);
+	TSharedPtr<FJsonObject> MapObject = MakeShared<FJsonObject>();
+
+	if (!ChargeDomBytes(Context, JsonObjectBytes + Helper.Num() * JsonFieldBytes)) return MapObject;
+	const SIZE_T ReservedSize = ReserveJsonObject(*MapObject, Helper.Num());
+
+	FPropertyTest TestValue = FPropertyTest(Helper.ValueProp);
+
+	int32 Index = 0;
+	for (FScriptMapHelper::FIterator Iter = Helper.CreateIterator(); Iter && !Context.bBudgetExceeded; Iter++, Index++)
+	{
+		const uint8* KeyData = Helper.GetKeyPtr(*Iter);
+		const uint8* ValData = Helper.GetValuePtr(*Iter);
+
+		if (KeyData == nullptr || ValData == nullptr) continue;
 
-		uint8* KeyData = Helper.GetKeyPtr(*Iter);
-		uint8* ValueData = Helper.GetValuePtr(*Iter);
+		FJsonPropertyPathScope PathScope(Context, nullptr, Index);
+		FString Key = MapKeyToString(Helper.KeyProp, KeyData);
+		ChargeDomBytes(Context, Key.Len() * sizeof(TCHAR));
+		MapObject->Values.Add(MoveTemp(Key), SerializePropertyAsJsonValue(ValData, Outer, TestValue, Context));
+	}
+	CountJsonContainerRegrowth(ReservedSize, MapObject->Values.GetAllocatedSize());
+
+	return MapObject;
+}
 
-		if (KeyData == nullptr || ValueData == nullptr) continue;
+static TSharedPtr<FJsonValue> SerializePropertyAsJsonValue(const void* ValueData, const UObject* Outer, const FPropertyTest& TestProp, FJsonSerializeContext& Context)
+{
+	if (Context.bBudgetExceeded) return nullptr;
 
-		if (TestKey.AsArray) // Array
+	if (TestProp.AsArray) // Array
+	{
+		return MakeShared<FJsonValueArray>(SerializeArrayPropertyAsJsonArray(ValueData, Outer, TestProp.AsArray, Context));
+	}
+	else if (TestProp.AsSet) // Set
+	{
+		return MakeShared<FJsonValueArray>(SerializeSetPropertyAsJsonArray(ValueData, Outer, TestProp.AsSet, Context));
+	}
+	else if (TestProp.AsMap) // Map
+	{
+		if (IsStringLikeMapKey(TestProp.AsMap->KeyProp))
 		{
-			TArray<TSharedPtr<FJsonValue>> InnerArray = SerializeArrayPropertyAsJsonArray(KeyData, Outer, TestKey.AsArray, TraversedObjects, bIncludeObjectClasses, bChangedPropertiesOnly);
-			KeyVal->SetArrayField("Key", InnerArray);
+			return MakeShared<FJsonValueObject>(SerializeMapPropertyAsJsonObject(ValueData, Outer, TestProp.AsMap, Context));
+		}
+		return MakeShared<FJsonValueArray>(SerializeMapPropertyAsJsonArray(ValueData, Outer, TestProp.AsMap, Context));
+	}
+	else if (TestProp.AsStruct) // Struct
+	{
+		return MakeShared<FJsonValueObject>(SerializeStructPropertyAsJsonObject(ValueData, Outer, TestProp.AsStruct, Context));
+	}
+	else if (TestProp.AsObject) // Object
+	{
+		return SerializeObjectPropertyAsJsonValue(TestProp.AsObject->GetObjectPropertyValue(ValueData), Outer, Context);
+	}
+
+	if (Context.MaxDomBytes > 0 && !ChargeDomBytes(Context, EstimateLeafBytes(TestProp.Raw, ValueData))) return nullptr;
+
+	if (TestProp.Leaf != EJsonLeafType::None)
+	{
+		return FJsonLeafCodec::Encode(TestProp.Leaf, TestProp.Raw, ValueData);
+	}
+	return FJsonObjectConverter::UPropertyToJsonValue(TestProp.Raw, ValueData);
+}
+
+static void SerializePropertyAsJsonObjectField(const void* Data, const UObject* Outer, TSharedPtr<FJsonObject> OuterObject, const FPropertyTest& TestProp, const FString& FieldName, FJsonSerializeContext& Context)
+{
+	/* if (TestProp.Raw->Identical_InContainer(Data, Outer->GetClass()->GetDefaultObject()) && Context.bChangedPropertiesOnly) return; */
+
+	FJsonPropertyPathScope PathScope(Context, &FieldName);
+	TSharedPtr<FJsonValue> Value = SerializePropertyAsJsonValue(TestProp.Raw->ContainerPtrToValuePtr<void>(Data), Outer, TestProp, Context);
+	if (Value.IsValid() && ChargeDomBytes(Context, JsonFieldBytes + FieldName.Len() * sizeof(TCHAR)))
+	{
+		OuterObject->SetField(FieldName, Value);
+	}
+}
+
+static void InitSerializeContext(FJsonSerializeContext& Context, const UObject* Object, bool bIncludeObjectClasses, bool bChangedPropertiesOnly, bool bPositionalProperties)
+{
+	Context.TraversedObjects.Add(Object);
+	Context.bIncludeObjectClasses = bIncludeObjectClasses || bPositionalProperties;
+	Context.bChangedPropertiesOnly = bChangedPropertiesOnly;
+	Context.bPositionalProperties = bPositionalProperties;
+
+	if (bPositionalProperties) {
+		Context.Schemas = MakeShared<FJsonObject>();
+	}
+}
+
+static TSharedPtr<FJsonObject> SerializeRootObject(const UObject* Object, FJsonSerializeContext& Context)
+{
+	TSharedPtr<FJsonObject> JsonObject = SerializeObjectAsJsonObject(Object, Context);
+
+	if (Context.bPositionalProperties) {
+		JsonObject->SetObjectField(FJsonSerializerFields::SchemasField.ToString(), Context.Schemas);
+	}
+
+	return JsonObject;
+}
+
+TSharedPtr<FJsonObject> FJsonSerializationModule::SerializeUObjectToJson(const UObject* Object, bool bIncludeObjectClasses, bool bChangedPropertiesOnly, bool bPositionalProperties)
+{
+	FJsonSerializeContext Context;
+	InitSerializeContext(Context, Object, bIncludeObjectClasses, bChangedPropertiesOnly, bPositionalProperties);
+	return SerializeRootObject(Object, Context);
+}
+
+TSharedPtr<FJsonObject> FJsonSerializationModule::SerializeUObjectToJson(const UObject* Object, TSet<const UObject*>& OutInlinedObjects, bool bIncludeObjectClasses, bool bPositionalProperties)
+{
+	FJsonSerializeContext Context;
+	InitSerializeContext(Context, Object, bIncludeObjectClasses, false, bPositionalProperties);
+	TSharedPtr<FJsonObject> JsonObject = SerializeRootObject(Object, Context);
+	OutInlinedObjects = MoveTemp(Context.TraversedObjects);
+	return JsonObject;
+}
+
+void FJsonSerializationModule::SerializeUObjectToJsonString(const UObject* Object, FString& OutJson, bool bIncludeObjectClasses, bool bChangedPropertiesOnly, bool bPositionalProperties)
+{
+	TSharedPtr<FJsonObject> JsonObject = SerializeUObjectToJson(Object, bIncludeObjectClasses, bChangedPropertiesOnly, bPositionalProperties);
+
+	// Size the text from what earlier calls for this class produced, with some headroom for growth
+	TSharedRef<const FJsonClassPlan> Plan = FJsonClassPlan::Get(Object->GetClass());
+	const int32 ExpectedLength = Plan->ExpectedTextLength.load(std::memory_order_relaxed);
+	OutJson.Reset(ExpectedLength + ExpectedLength / 8);
+	const int32 ReservedCapacity = OutJson.GetCharArray().Max();
+
+	FJsonTextWriter::WriteObject(*JsonObject, OutJson);
+
+	if (OutJson.GetCharArray().Max() != ReservedCapacity) {
+		INC_DWORD_STAT(STAT_JsonOutputRegrowths);
+	}
+	INC_DWORD_STAT_BY(STAT_JsonOutputChars, OutJson.Len());
+
+	// Follow growth right away, shrink slowly
+	const int32 Length = OutJson.Len() + 1;
+	Plan->ExpectedTextLength.store(Length > ExpectedLength ? Length : (ExpectedLength * 3 + Length) / 4, std::memory_order_relaxed);
+}
+
+TSharedPtr<FJsonObject> FJsonSerializationModule::SerializeUObjectToJsonWithBudget(const UObject* Object, const FJsonSerializationBudget& Budget, FJsonSerializationReport& OutReport, bool bIncludeObjectClasses, bool bChangedPropertiesOnly, bool bPositionalProperties)
+{
+	OutReport = FJsonSerializationReport();
+
+	FJsonSerializeContext Context;
+	InitSerializeContext(Context, Object, bIncludeObjectClasses, bChangedPropertiesOnly, bPositionalProperties);
+	Context.MaxDomBytes = Budget.MaxDomBytes;
+
+	TSharedPtr<FJsonObject> JsonObject = SerializeRootObject(Object, Context);
+	OutReport.EstimatedDomBytes = Context.DomBytes;
+
+	if (!Context.bBudgetExceeded) {
+		return JsonObject;
+	}
+
+	// Drop the partial DOM before anything else is written
+	JsonObject.Reset();
+
+	OutReport.bBudgetExceeded = true;
+	OutReport.ExceededPropertyPath = Context.ExceededPropertyPath;
+	UE_LOG(LogJsonSerialization, Warning, TEXT("Serializing %s exceeded the %lld byte budget at %s"),
+		*Object->GetPathName(), Budget.MaxDomBytes, *OutReport.ExceededPropertyPath);
+
+	if (Budget.SpillArchive) {
+		OutReport.bSpilled = SerializeUObjectToJsonStream(Object, *Budget.SpillArchive, bIncludeObjectClasses, bChangedPropertiesOnly, bPositionalProperties);
+	}
+
+	return nullptr;
+}
+
+// STREAMING
+
+using FJsonStreamWriter = TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>;
+
+// Receives the UTF-16 output of a TCHAR json writer and forwards it to another archive as UTF-8
+class FJsonUtf8StreamArchive : public FArchive
+{
+public:
+	FJsonUtf8StreamArchive(FArchive& InTarget)
+		: Target(InTarget)
+	{
+		SetIsSaving(true);
+	}
+
+	virtual void Serialize(void* Data, int64 Num) override
+	{
+		Pending.Append((const TCHAR*)Data, Num / sizeof(TCHAR));
+		if (Pending.Num() >= 64 * 1024) {
+			Flush();
 		}
-		if (TestKey.AsSet) // Set
+	}
+
+	virtual void Flush() override
+	{
+		int32 Count = Pending.Num();
+
+		// Hold back a trailing high surrogate until the rest of its pair arrives
+		if (Count > 0 && Pending[Count - 1] >= 0xD800 && Pending[Count - 1] <= 0xDBFF) {
+			--Count;
+		}
+
+		FTCHARToUTF8 Utf8(Pending.GetData(), Count);
+		Target.Serialize((void*)Utf8.Get(), Utf8.Length());
+		Pending.RemoveAt(0, Count);
+	}
+
+	virtual FString GetArchiveName() const override
+	{
+		return TEXT("FJsonUtf8StreamArchive");
+	}
+
+private:
+	FArchive& Target;
+	TArray<TCHAR> Pending;
+};
+
+static void StreamPropertyValue(FJsonStreamWriter& Writer, const void* ValueData, const UObject* Outer, const FPropertyTest& TestProp, FJsonSerializeContext& Context);
+
+static void StreamJsonValue(FJsonStreamWriter& Writer, const TSharedPtr<FJsonValue>& Value)
+{
+	switch (Value.IsValid() ? Value->Type : EJson::Null)
+	{
+	case EJson::Boolean:
+		Writer.WriteValue(Value->AsBool());
+		break;
+	case EJson::Number:
+		Writer.WriteValue(Value->AsNumber());
+		break;
+	case EJson::String:
+		Writer.WriteValue(Value->AsString());
+		break;
+	case EJson::Array:
+		Writer.WriteArrayStart();
+		for (const TSharedPtr<FJsonValue>& Element : Value->AsArray())
 		{
-			TArray<TSharedPtr<FJsonValue>> InnerArray = SerializeSetPropertyAsJsonArray(KeyData, Outer, TestKey.AsSet, TraversedObjects, bIncludeObjectClasses, bChangedPropertiesOnly);
-			KeyVal->SetArrayField("Key", InnerArray);
+			StreamJsonValue(Writer, Element);
 		}
-		if (TestKey.AsMap) // Map
+		Writer.WriteArrayEnd();
+		break;
+	case EJson::Object:
+		Writer.WriteObjectStart();
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : Value->AsObject()->Values)
 		{
-			TArray<TSharedPtr<FJsonValue>> InnerArray = SerializeMapPropertyAsJsonArray(KeyData, Outer, TestKey.AsMap, TraversedObjects, bIncludeObjectClasses, bChangedPropertiesOnly);
-			KeyVal->SetArrayField("Key", InnerArray);
+			Writer.WriteIdentifierPrefix(Pair.Key);
+			StreamJsonValue(Writer, Pair.Value);
 		}
-		else if (TestKey.AsStruct) // Struct
+		Writer.WriteObjectEnd();
+		break;
+	default:
+		Writer.WriteNull();
+		break;
+	}
+}
+
+static void StreamStructProperties(FJsonStreamWriter& Writer, const void* Data, const UObject* Outer, const FJsonClassPlan& Plan, FJsonSerializeContext& Context)
+{
+	for (int32 i = 0; i < Plan.Properties.Num(); ++i)
+	{
+		const FPropertyTest& TestProp = Plan.PropertyTests[i];
+		Writer.WriteIdentifierPrefix(Plan.PropertyNames[i]);
+		StreamPropertyValue(Writer, TestProp.Raw->ContainerPtrToValuePtr<void>(Data), Outer, TestProp, Context);
+	}
+}
+
+static void StreamObject(FJsonStreamWriter& Writer, const UObject* Object, FJsonSerializeContext& Context, bool bIsRoot)
+{
+	TSharedRef<const FJsonClassPlan> Plan = FJsonClassPlan::Get(Object->GetClass());
+
+	Writer.WriteObjectStart();
+	if (Context.bPositionalProperties)
+	{
+		Writer.WriteValue(FJsonSerializerFields::ObjectClassField.ToString(), Object->GetClass()->GetPathName());
+		Writer.WriteValue(FJsonSerializerFields::ObjectSchemaField.ToString(), Plan->Fingerprint);
+		Context.StreamedSchemas.Add(Plan->Fingerprint, Plan);
+
+		Writer.WriteArrayStart(FJsonSerializerFields::ObjectPropertiesField.ToString());
+		for (const FPropertyTest& TestProp : Plan->PropertyTests)
 		{
-			TSharedPtr<FJsonObject> StructObject = MakeShareable(new FJsonObject);
-			SerializeStructPropertyAsJsonObjectField(KeyData, Outer, TestKey.AsStruct, StructObject, TraversedObjects, bIncludeObjectClasses, bChangedPropertiesOnly);
-			KeyVal->SetObjectField("Key", StructObject);
+			StreamPropertyValue(Writer, TestProp.Raw->ContainerPtrToValuePtr<void>(Object), Object, TestProp, Context);
 		}
-		else if (TestKey.AsObject) // Object
+		Writer.WriteArrayEnd();
+	}
+	else if (Context.bIncludeObjectClasses)
+	{
+		Writer.WriteValue(FJsonSerializerFields::ObjectClassField.ToString(), Object->GetClass()->GetPathName());
+		Writer.WriteObjectStart(FJsonSerializerFields::ObjectPropertiesField.ToString());
+		StreamStructProperties(Writer, Object, Object, *Plan, Context);
+		Writer.WriteObjectEnd();
+	}
+	else
+	{
+		StreamStructProperties(Writer, Object, Object, *Plan, Context);
+	}
+
+	// The schema table goes last, once every class in the document has been seen
+	if (bIsRoot && Context.bPositionalProperties)
+	{
+		Writer.WriteObjectStart(FJsonSerializerFields::SchemasField.ToString());
+		for (const TPair<FString, TSharedRef<const FJsonClassPlan>>& Schema : Context.StreamedSchemas)
 		{
-			const UObject* SubObject = TestKey.AsObject->GetObjectPropertyValue(KeyData);
-			if (SubObject->IsValidLowLevel() && SubObject->GetOuter() == Outer && !TraversedObjects.Contains(SubObject))
+			Writer.WriteArrayStart(Schema.Key);
+			for (const FString& Name : Schema.Value->PropertyNames)
 			{
-				TraversedObjects.Add(SubObject);
-				TSharedPtr<FJsonObject> JsonSubObject = MakeShared<FJsonObject>();
-				TSharedPtr<FJsonObject> JsonSubObjectProperties = JsonSubObject;
-
-				if (bIncludeObjectClasses) {
-					JsonSubObjectProperties = MakeShared<FJsonObject>();
-					JsonSubObject->SetStringField(FJsonSerializerFields::ObjectClassField.ToString(), SubObject->GetClass()->GetPathName());
-					JsonSubObject->SetObjectField(FJsonSerializerFields::ObjectPropertiesField.ToString(), JsonSubObjectProperties);
-				}
-
-				for (TFieldIterator<FProperty> PropertyItr(SubObject->GetClass()); PropertyItr; ++PropertyItr)
-				{
-					SerializePropertyAsJsonObjectField(SubObject, SubObject, JsonSubObjectProperties, *PropertyItr, TraversedObjects, bIncludeObjectClasses, bChangedPropertiesOnly);
-				}
-				KeyVal->SetObjectField("Key", JsonSubObject);
-			}
-			else {
-				KeyVal->SetStringField("Key", SubObject->GetPathName());
+				Writer.WriteValue(Name);
 			}
+			Writer.WriteArrayEnd();
 		}
-		else
+		Writer.WriteObjectEnd();
+	}
+	Writer.WriteObjectEnd();
+}
+
+static void StreamPropertyValue(FJsonStreamWriter& Writer, const void* ValueData, const UObject* Outer, const FPropertyTest& TestProp, FJsonSerializeContext& Context)
+{
+	if (TestProp.AsArray) // Array
+	{
+		FScriptArrayHelper Helper(TestProp.AsArray, ValueData);
+		FPropertyTest TestInner = FPropertyTest(TestProp.AsArray->Inner);
+
+		Writer.WriteArrayStart();
+		for (int32 i = 0, n = Helper.Num(); i < n; ++i)
 		{
-			TSharedPtr<FJsonValue> JsonValue;
-			KeyVal->SetField("Key", FJsonObjectConverter::UPropertyToJsonValue(TestKey.Raw, KeyData));
+			StreamPropertyValue(Writer, Helper.GetRawPtr(i), Outer, TestInner, Context);
 		}
+		Writer.WriteArrayEnd();
+	}
+	else if (TestProp.AsSet) // Set
+	{
+		FScriptSetHelper Helper(TestProp.AsSet, ValueData);
+		FPropertyTest TestElement = FPropertyTest(TestProp.AsSet->ElementProp);
 
-		if (TestValue.AsArray) // Array
+		Writer.WriteArrayStart();
+		for (FScriptSetHelper::FIterator Iter = Helper.CreateIterator(); Iter; Iter++)
 		{
-			TArray<TSharedPtr<FJsonValue>> InnerArray = SerializeArrayPropertyAsJsonArray(ValueData, Outer, TestValue.AsArray, TraversedObjects, bIncludeObjectClasses, bChangedPropertiesOnly);
-			KeyVal->SetArrayField("Value", InnerArray);
+			StreamPropertyValue(Writer, Helper.GetElementPtr(*Iter), Outer, TestElement, Context);
 		}
-		if (TestValue.AsSet) // Set
+		Writer.WriteArrayEnd();
+	}
+	else if (TestProp.AsMap) // Map
+	{
+		FScriptMapHelper Helper(TestProp.AsMap, ValueData);
+		FPropertyTest TestKey = FPropertyTest(Helper.KeyProp);
+		FPropertyTest TestValue = FPropertyTest(Helper.ValueProp);
+		const bool bStringKeys = IsStringLikeMapKey(Helper.KeyProp);
+
+		if (bStringKeys) Writer.WriteObjectStart();
+		else Writer.WriteArrayStart();
+
+		for (FScriptMapHelper::FIterator Iter = Helper.CreateIterator(); Iter; Iter++)
 		{
-			TArray<TSharedPtr<FJsonValue>> InnerArray = SerializeSetPropertyAsJsonArray(ValueData, Outer, TestValue.AsSet, TraversedObjects, bIncludeObjectClasses, bChangedPropertiesOnly);
-			KeyVal->SetArrayField("Value", InnerArray);
+			const uint8* KeyData = Helper.GetKeyPtr(*Iter);
+			const uint8* ValData = Helper.GetValuePtr(*Iter);
+
+			if (KeyData == nullptr || ValData == nullptr) continue;
+
+			if (bStringKeys) {
+				Writer.WriteIdentifierPrefix(MapKeyToString(Helper.KeyProp, KeyData));
+				StreamPropertyValue(Writer, ValData, Outer, TestValue, Context);
+			}
+			else {
+				Writer.WriteObjectStart();
+				Writer.WriteIdentifierPrefix(TEXT("Key"));
+				StreamPropertyValue(Writer, KeyData, Outer, TestKey, Context);
+				Writer.WriteIdentifierPrefix(TEXT("Value"));
+				StreamPropertyValue(Writer, ValData, Outer, TestValue, Context);
+				Writer.WriteObjectEnd();
+			}
 		}
-		if (TestValue.AsMap) // Map
+
+		if (bStringKeys) Writer.WriteObjectEnd();
+		else Writer.WriteArrayEnd();
+	}
+	else if (TestProp.AsStruct) // Struct
+	{
+		const UStruct* Struct = TestProp.AsStruct->Struct;
+		if (Struct == TBaseStructure<FInstancedStruct>::Get())
 		{
-			TArray<TSharedPtr<FJsonValue>> InnerArray = SerializeMapPropertyAsJsonArray(ValueData, Outer, TestValue.AsMap, TraversedObjects, bIncludeObjectClasses, bChangedPropertiesOnly);
-			KeyVal->SetArrayField("Value", InnerArray);
+			const FInstancedStruct& InstancedStruct = *(const FInstancedStruct*)ValueData;
+			Struct = InstancedStruct.GetScriptStruct();
+			ValueData = InstancedStruct.GetMemory();
 		}
-		else if (TestValue.AsStruct) // Struct
+
+		Writer.WriteObjectStart();
+		if (Struct != nullptr)
 		{
-			TSharedPtr<FJsonObject> StructObject = MakeShareable(new FJsonObject);
-			SerializeStructPropertyAsJsonObjectField(ValueData, Outer, TestValue.AsStruct, StructObject, TraversedObjects, bIncludeObjectClasses, bChangedPropertiesOnly);
-			KeyVal->SetObjectField("Value", StructObject);
+			StreamStructProperties(Writer, ValueData, Outer, *FJsonClassPlan::Get(Struct), Context);
 		}
-		else if (TestValue.AsObject) // Object
+		Writer.WriteObjectEnd();
+	}
+	else if (TestProp.AsObject) // Object
+	{
+		const UObject* SubObject = TestProp.AsObject->GetObjectPropertyValue(ValueData);
+		if (SubObject->IsValidLowLevel() && SubObject->GetOuter() == Outer && !Context.TraversedObjects.Contains(SubObject))
 		{
-			const UObject* SubObject = TestValue.AsObject->GetObjectPropertyValue(ValueData);
-			if (SubObject->IsValidLowLevel() && SubObject->GetOuter() == Outer && !TraversedObjects.Contains(SubObject))
-			{
-				TraversedObjects.Add(SubObject);
-				TSharedPtr<FJsonObject> JsonSubObject = MakeShared<FJsonObject>();
-				TSharedPtr<FJsonObject> JsonSubObjectProperties = JsonSubObject;
-
-				if (bIncludeObjectClasses) {
-					JsonSubObjectProperties = MakeShared<FJsonObject>();
-					JsonSubObject->SetStringField(FJsonSerializerFields::ObjectClassField.ToString(), SubObject->GetClass()->GetPathName());
-					JsonSubObject->SetObjectField(FJsonSerializerFields::ObjectPropertiesField.ToString(), JsonSubObjectProperties);
-				}
-
-				for (TFieldIterator<FProperty> PropertyItr(SubObject->GetClass()); PropertyItr; ++PropertyItr)
-				{
-					SerializePropertyAsJsonObjectField(SubObject, SubObject, JsonSubObjectProperties, *PropertyItr, TraversedObjects, bIncludeObjectClasses, bChangedPropertiesOnly);
-				}
-				KeyVal->SetObjectField("Value", JsonSubObject);
-			}
-			else {
-				KeyVal->SetStringField("Value", SubObject->GetPathName());
-			}
+			Context.TraversedObjects.Add(SubObject);
+			StreamObject(Writer, SubObject, Context, false);
 		}
 		else
 		{
-			TSharedPtr<FJsonValue> JsonValue;
-			KeyVal->SetField("Value", FJsonObjectConverter::UPropertyToJsonValue(TestValue.Raw, ValueData));
+			Writer.WriteValue(SubObject->GetPathName());
 		}
+	}
+	else if (TestProp.Leaf != EJsonLeafType::None)
+	{
+		FJsonLeafCodec::Write(Writer, TestProp.Leaf, TestProp.Raw, ValueData);
+	}
+	else
+	{
+		StreamJsonValue(Writer, FJsonObjectConverter::UPropertyToJsonValue(TestProp.Raw, ValueData));
+	}
+}
 
+bool FJsonSerializationModule::SerializeUObjectToJsonStream(const UObject* Object, FArchive& Archive, bool bIncludeObjectClasses, bool bChangedPropertiesOnly, bool bPositionalProperties)
+{
+	FJsonSerializeContext Context;
+	InitSerializeContext(Context, Object, bIncludeObjectClasses, bChangedPropertiesOnly, bPositionalProperties);
 
-		ValueArray.Emplace(new FJsonValueObject(KeyVal));
-	}
-	
-	return ValueArray;
+	FJsonUtf8StreamArchive Utf8Archive(Archive);
+	TSharedRef<FJsonStreamWriter> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Utf8Archive);
+
+	StreamObject(*Writer, Object, Context, true);
+
+	const bool bClosed = Writer->Close();
+	Utf8Archive.Flush();
+	return bClosed && !Archive.IsError();
+}
+
+// DESERIALIZATION
+
+static bool HasObjectFields(TSharedPtr<FJsonObject> JsonObject);
+static void DeserializePropertyFromJsonValue(void* ValueData, UObject* Owner, const TSharedPtr<FJsonValue>& FieldValue, const FPropertyTest& TestProperty, FJsonDeserializeContext& Context);
+static void DeserializePropertyFromJsonObjectField(void* Data, UObject* Owner, TSharedPtr<FJsonObject> JsonObjectProperties, const FJsonClassPlan& Plan, int32 PropertyIndex, FJsonDeserializeContext& Context);
+static void DeserializePropertiesFromJsonObject(void* Data, UObject* Owner, TSharedPtr<FJsonObject> JsonObjectProperties, const UStruct* Struct, FJsonDeserializeContext& Context);
+static void DeserializeArrayPropertyFromJsonObjectField(void* FieldData, UObject* Owner, const TArray<TSharedPtr<FJsonValue>>& JsonArrayField, FArrayProperty* ArrayProperty, FJsonDeserializeContext& Context);
+static void DeserializeSetPropertyFromJsonObjectField(void* FieldData, UObject* Owner, const TArray<TSharedPtr<FJsonValue>>& JsonArrayField, FSetProperty* SetProperty, FJsonDeserializeContext& Context);
+static void DeserializeMapPropertyFromJsonObjectField(void* FieldData, UObject* Owner, const TArray<TSharedPtr<FJsonValue>>& JsonArrayField, FMapProperty* MapProperty, FJsonDeserializeContext& Context);
+static void DeserializeMapPropertyFromJsonObject(void* FieldData, UObject* Owner, TSharedPtr<FJsonObject> JsonMapObject, FMapProperty* MapProperty, FJsonDeserializeContext& Context);
+static void DeserializeStructPropertyFromJsonObjectField(void* FieldData, UObject* Owner, TSharedPtr<FJsonObject> JsonStructField, FStructProperty* StructProperty, FJsonDeserializeContext& Context);
+static void DeserializeObjectPropertyFromJsonValue(void* FieldData, UObject* Owner, const TSharedPtr<FJsonValue>& FieldValue, FObjectProperty* ObjectProperty, FJsonDeserializeContext& Context);
+static void DeserializeObjectFromJsonObject(UObject*& Object, TSharedPtr<FJsonObject> JsonObject, FJsonDeserializeContext& Context);
+
+
+bool HasObjectFields(TSharedPtr<FJsonObject> JsonObject)
+{
+	return /*JsonObject->HasField(FJsonSerializationModule::ObjectNameField.ToString())
+		&& */JsonObject->HasField(FJsonSerializerFields::ObjectClassField.ToString())
+		&& JsonObject->HasField(FJsonSerializerFields::ObjectPropertiesField.ToString());
 }
 
-static void SerializePropertyAsJsonObjectField(const void* Data, const UObject* Outer, TSharedPtr<FJsonObject> OuterObject, FProperty* Property, TSet<const UObject*>& TraversedObjects, bool bIncludeObjectClasses, bool bChangedPropertiesOnly)
+static void DeserializeStructPropertyFromJsonObjectField(void* FieldData, UObject* Owner, TSharedPtr<FJsonObject> JsonStructField, FStructProperty* StructProperty, FJsonDeserializeContext& Context)
 {
-	if (Property->GetName() == "UberGraphFrame"
-		|| Property->HasAnyPropertyFlags(CPF_Transient)
-		/* || (Property->Identical_InContainer(Data, Outer->GetClass()->GetDefaultObject()) && bChangedPropertiesOnly)*/)
+	if (StructProperty->Struct == TBaseStructure<FInstancedStruct>::Get())
+	{
+		FInstancedStruct& InstancedStruct = *(FInstancedStruct*)FieldData;
+		if (InstancedStruct.GetScriptStruct() == nullptr) return;
+
+		DeserializePropertiesFromJsonObject(InstancedStruct.GetMutableMemory(), Owner, JsonStructField, InstancedStruct.GetScriptStruct(), Context);
+	}
+	else
+	{
+		DeserializePropertiesFromJsonObject(FieldData, Owner, JsonStructField, StructProperty->Struct, Context);
+	}
+}
+
+
+static void DeserializeArrayPropertyFromJsonObjectField(void* FieldData, UObject* Owner, const TArray<TSharedPtr<FJsonValue>>& JsonArrayField, FArrayProperty* ArrayProperty, FJsonDeserializeContext& Context) {
+	if (FieldData == nullptr
+		|| Owner == nullptr
+		|| ArrayProperty == nullptr)
 	{
-		// Don't include "UberGraphFrame" or any transient properties
 		return;
 	}
 
 
-	FPropertyTest TestProp = FPropertyTest(Property);
+	FScriptArrayHelper Helper(ArrayProperty, FieldData);
+	Helper.Resize(0);
+	Helper.AddValues(JsonArrayField.Num());
 
-	if (TestProp.AsArray) // Array
-	{
-		TArray<TSharedPtr<FJsonValue>> Values = SerializeArrayPropertyAsJsonArray(Data, Outer, TestProp.AsArray, TraversedObjects, bIncludeObjectClasses, bChangedPropertiesOnly);
-		OuterObject->SetArrayField(Property->GetAuthoredName(), Values);
+	FPropertyTest TestProperty = FPropertyTest(ArrayProperty->Inner);
+
+	for (int32 i = 0, n = Helper.Num(); i < n; ++i) {
+		DeserializePropertyFromJsonValue(Helper.GetRawPtr(i), Owner, JsonArrayField[i], TestProperty, Context);
 	}
-	if (TestProp.AsSet) // Set
+}
+
+static void DeserializeSetPropertyFromJsonObjectField(void* FieldData, UObject* Owner, const TArray<TSharedPtr<FJsonValue>>& JsonArrayField, FSetProperty* SetProperty, FJsonDeserializeContext& Context) {
+	if (FieldData == nullptr
+		|| Owner == nullptr
+		|| SetProperty == nullptr)
 	{
-		TArray<TSharedPtr<FJsonValue>> Values = SerializeSetPropertyAsJsonArray(Data, Outer, TestProp.AsSet, TraversedObjects, bIncludeObjectClasses, bChangedPropertiesOnly);
-		OuterObject->SetArrayField(Property->GetAuthoredName(), Values);
+		return;
 	}
-	if (TestProp.AsMap) // Map
-	{
-		TArray<TSharedPtr<FJsonValue>> Values = SerializeMapPropertyAsJsonArray(Data, Outer, TestProp.AsMap, TraversedObjects, bIncludeObjectClasses, bChangedPropertiesOnly);
-		OuterObject->SetArrayField(Property->GetAuthoredName(), Values);
+
+
+	FScriptSetHelper Helper(SetProperty, FieldData);
+	Helper.EmptyElements(JsonArrayField.Num());
+	FPropertyTest TestProperty = FPropertyTest(SetProperty->ElementProp);
+
+	for (int32 i = 0, n = JsonArrayField.Num(); i < n; ++i) {
+		int32 NewIndex = Helper.AddDefaultValue_Invalid_NeedsRehash();
+		DeserializePropertyFromJsonValue(Helper.GetElementPtr(NewIndex), Owner, JsonArrayField[i], TestProperty, Context);
 	}
-	else if (TestProp.AsStruct) // Struct
+
+	Helper.Rehash();
+}
+
+void DeserializeMapPropertyFromJsonObjectField(void* FieldData, UObject* Owner, const TArray<TSharedPtr<FJsonValue>>& JsonArrayField, FMapProperty* MapProperty, FJsonDeserializeContext& Context)
+{
+	if (FieldData == nullptr
+		|| Owner == nullptr
+		|| MapProperty == nullptr)
 	{
-		TSharedPtr<FJsonObject> StructObject = MakeShareable(new FJsonObject);
-		SerializeStructPropertyAsJsonObjectField(Data, Outer, TestProp.AsStruct, StructObject, TraversedObjects, bIncludeObjectClasses, bChangedPropertiesOnly);
-		OuterObject->SetObjectField(Property->GetAuthoredName(), StructObject);
+		return;
 	}
-	else if (TestProp.AsObject) // Object
+
+
+	FScriptMapHelper Helper(MapProperty, FieldData);
+	Helper.EmptyValues(JsonArrayField.Num());
+
+	FPropertyTest TestKey = FPropertyTest(Helper.KeyProp);
+	FPropertyTest TestValue = FPropertyTest(Helper.ValueProp);
+
+	for (int32 i = 0, n = JsonArrayField.Num(); i < n; ++i) {
+
+		const TSharedPtr<FJsonValue>& FieldValue = JsonArrayField[i];
+
+		if (FieldValue->Type != EJson::Object) continue;
+
+		TSharedPtr<FJsonObject> KeyValObject = FieldValue->AsObject();
+		TSharedPtr<FJsonValue> KeyValue = KeyValObject->TryGetField("Key");
+		TSharedPtr<FJsonValue> ValValue = KeyValObject->TryGetField("Value");
+
+		if (!KeyValue.IsValid() || !ValValue.IsValid()) continue;
+
+		int32 NewIndex = Helper.AddDefaultValue_Invalid_NeedsRehash();
+		DeserializePropertyFromJsonValue(Helper.GetKeyPtr(NewIndex), Owner, KeyValue, TestKey, Context);
+		DeserializePropertyFromJsonValue(Helper.GetValuePtr(NewIndex), Owner, ValValue, TestValue, Context);
+	}
+
+	Helper.Rehash();
+}
+
+static void DeserializeMapPropertyFromJsonObject(void* FieldData, UObject* Owner, TSharedPtr<FJsonObject> JsonMapObject, FMapProperty* MapProperty, FJsonDeserializeContext& Context)
+{
+	if (FieldData == nullptr
+		|| Owner == nullptr
+		|| MapProperty == nullptr
+		|| !IsStringLikeMapKey(MapProperty->KeyProp))
 	{
-		const UObject* SubObject = TestProp.AsObject->GetObjectPropertyValue_InContainer(Data);
-		if (SubObject->IsValidLowLevel() && SubObject->GetOuter() == Outer && !TraversedObjects.Contains(SubObject))
-		{
-			TraversedObjects.Add(SubObject);
-			TSharedPtr<FJsonObject> JsonSubObject = MakeShared<FJsonObject>();
-			TSharedPtr<FJsonObject> JsonSubObjectProperties = JsonSubObject;
-
-			if (bIncludeObjectClasses) {
-				JsonSubObjectProperties = MakeShared<FJsonObject>();
-				JsonSubObject->SetStringField(FJsonSerializerFields::ObjectClassField.ToString(), SubObject->GetClass()->GetPathName());
-				JsonSubObject->SetObjectField(FJsonSerializerFields::ObjectPropertiesField.ToString(), JsonSubObjectProperties);
-			}
+		return;
+	}
 
-			for (TFieldIterator<FProperty> PropertyItr(SubObject->GetClass()); PropertyItr; ++PropertyItr)
-			{
-				SerializePropertyAsJsonObjectField(SubObject, SubObject, JsonSubObjectProperties, *PropertyItr, TraversedObjects, bIncludeObjectClasses, bChangedPropertiesOnly);
-			}
-			OuterObject->SetObjectField(Property->GetAuthoredName(), JsonSubObject);
+	FScriptMapHelper Helper(MapProperty, FieldData);
+	Helper.EmptyValues(JsonMapObject->Values.Num());
+
+	FPropertyTest TestValue = FPropertyTest(Helper.ValueProp);
+
+	for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : JsonMapObject->Values) {
+		int32 NewIndex = Helper.AddDefaultValue_Invalid_NeedsRehash();
+		MapKeyFromString(Helper.KeyProp, Helper.GetKeyPtr(NewIndex), Pair.Key);
+		DeserializePropertyFromJsonValue(Helper.GetValuePtr(NewIndex), Owner, Pair.Value, TestValue, Context);
+	}
+
+	Helper.Rehash();
+}
+
+static void DeserializeObjectPropertyFromJsonValue(void* FieldData, UObject* Owner, const TSharedPtr<FJsonValue>& FieldValue, FObjectProperty* ObjectProperty, FJsonDeserializeContext& Context)
+{
+	UObject* SubObject = ObjectProperty->GetObjectPropertyValue(FieldData);
+	bool bIsSubObjectToImport = FieldValue->Type == EJson::Object;
+
+	if (bIsSubObjectToImport) {
+		DeserializeObjectFromJsonObject(SubObject, FieldValue->AsObject(), Context);
+	}
+	else if (FieldValue->Type == EJson::String) {
+		FString ObjectPathName = FieldValue->AsString();
+		SubObject = StaticLoadObject(UObject::StaticClass(), nullptr, *ObjectPathName);
+	}
+	else {
+		return;
+	}
+
+	if (SubObject != nullptr && bIsSubObjectToImport) {
+		SubObject->Rename(nullptr, Owner);
+	}
+
+	ObjectProperty->SetObjectPropertyValue(FieldData, SubObject);
+}
+
+static void DeserializePropertyFromJsonValue(void* ValueData, UObject* Owner, const TSharedPtr<FJsonValue>& FieldValue, const FPropertyTest& TestProperty, FJsonDeserializeContext& Context)
+{
+	if (!FieldValue.IsValid()) return;
+
+	if (TestProperty.AsArray) {
+		if (FieldValue->Type != EJson::Array) return;
+		DeserializeArrayPropertyFromJsonObjectField(ValueData, Owner, FieldValue->AsArray(), TestProperty.AsArray, Context);
+	}
+	else if (TestProperty.AsSet) {
+		if (FieldValue->Type != EJson::Array) return;
+		DeserializeSetPropertyFromJsonObjectField(ValueData, Owner, FieldValue->AsArray(), TestProperty.AsSet, Context);
+	}
+	else if (TestProperty.AsMap) {
+		// Maps with string-like keys are written as objects; the array of key/value pairs is still accepted
+		if (FieldValue->Type == EJson::Object) {
+			DeserializeMapPropertyFromJsonObject(ValueData, Owner, FieldValue->AsObject(), TestProperty.AsMap, Context);
 		}
-		else {
-			OuterObject->SetStringField(Property->GetAuthoredName(), SubObject->GetPathName());
+		else if (FieldValue->Type == EJson::Array) {
+			DeserializeMapPropertyFromJsonObjectField(ValueData, Owner, FieldValue->AsArray(), TestProperty.AsMap, Context);
 		}
 	}
-	else
-	{
-		TSharedPtr<FJsonValue> JsonValue;
-		const uint8* PropData = Property->ContainerPtrToValuePtr<uint8>(Data);
-		OuterObject->SetField(Property->GetAuthoredName(), FJsonObjectConverter::UPropertyToJsonValue(Property, PropData));
+	else if (TestProperty.AsStruct) {
+		if (FieldValue->Type != EJson::Object) return;
+		DeserializeStructPropertyFromJsonObjectField(ValueData, Owner, FieldValue->AsObject(), TestProperty.AsStruct, Context);
+	}
+	else if (TestProperty.AsObject) {
+		DeserializeObjectPropertyFromJsonValue(ValueData, Owner, FieldValue, TestProperty.AsObject, Context);
+	}
+	else if (TestProperty.Leaf == EJsonLeafType::None || !FJsonLeafCodec::Decode(TestProperty.Leaf, FieldValue, TestProperty.Raw, ValueData)) {
+		FJsonObjectConverter::JsonValueToUProperty(FieldValue, TestProperty.Raw, ValueData);
 	}
 }
 
-TSharedPtr<FJsonObject> FJsonSerializationModule::SerializeUObjectToJson(const UObject* Object, bool bIncludeObjectClasses, bool bChangedPropertiesOnly)
+// Applies the registered migrations of one property. A missing current key is looked up under the property's old
+// keys first, then retyped values are converted, whichever key they were found under
+static TSharedPtr<FJsonValue> MigrateFieldValue(TSharedPtr<FJsonValue> FieldValue, TFunctionRef<TSharedPtr<FJsonValue>(const FString&)> FindField, const TArray<FJsonClassPlan::FMigration>& Migrations)
 {
-	TSet<const UObject*> TraversedObjects;
-	TraversedObjects.Add(Object);
-
-	TSharedPtr<FJsonObject> JsonObject = MakeShared<FJsonObject>();
-	TSharedPtr<FJsonObject> JsonObjectProperties = JsonObject;
-
-	if (bIncludeObjectClasses) {
-		JsonObjectProperties = MakeShared<FJsonObject>();
-		JsonObject->SetStringField(FJsonSerializerFields::ObjectClassField.ToString(), Object->GetClass()->GetPathName());
-		JsonObject->SetObjectField(FJsonSerializerFields::ObjectPropertiesField.ToString(), JsonObjectProperties);
+	for (const FJsonClassPlan::FMigration& Migration : Migrations)
+	{
+		if (!Migration.OldKey.IsEmpty() && !FieldValue.IsValid()) {
+			TSharedPtr<FJsonValue> OldValue = FindField(Migration.OldKey);
+			if (OldValue.IsValid()) {
+				FieldValue = Migration.Converter ? Migration.Converter(OldValue) : OldValue;
+			}
+		}
 	}
 
-	for (TFieldIterator<FProperty> PropertyItr(Object->GetClass()); PropertyItr; ++PropertyItr)
+	for (const FJsonClassPlan::FMigration& Migration : Migrations)
 	{
-		SerializePropertyAsJsonObjectField(Object, Object, JsonObjectProperties, *PropertyItr, TraversedObjects, bIncludeObjectClasses, bChangedPropertiesOnly);
+		if (Migration.OldKey.IsEmpty() && FieldValue.IsValid() && FieldValue->Type == Migration.OldType) {
+			FieldValue = Migration.Converter(FieldValue);
+		}
 	}
-
-	return JsonObject;
+	return FieldValue;
 }
 
-// DESERIALIZATION
-
-static bool HasObjectFields(TSharedPtr<FJsonObject> JsonObject);
-static void DeserializePropertyFromJsonObjectField(void* Data, UObject* Owner, TSharedPtr<FJsonObject> JsonObjectProperties, FProperty* Property, bool bIncludeObjectClasses);
-static void DeserializeArrayPropertyFromJsonObjectField(void* FieldData, UObject* Owner, TArray<TSharedPtr<FJsonValue>> JsonArrayField, FArrayProperty* ArrayProperty, bool bIncludeObjectClasses);
-static void DeserializeSetPropertyFromJsonObjectField(void* FieldData, UObject* Owner, TArray<TSharedPtr<FJsonValue>> JsonArrayField, FSetProperty* SetProperty, bool bIncludeObjectClasses);
-static void DeserializeMapPropertyFromJsonObjectField(void* FieldData, UObject* Owner, TArray<TSharedPtr<FJsonValue>> JsonArrayField, FMapProperty* MapProperty, bool bIncludeObjectClasses);
-static void DeserializeStructPropertyFromJsonObjectField(void* FieldData, UObject* Owner, TSharedPtr<FJsonObject> JsonStructField, FStructProperty* StructProperty, bool bIncludeObjectClasses);
+static void DeserializePropertyFromJsonObjectField(void* Data, UObject* Owner, TSharedPtr<FJsonObject> JsonObjectProperties, const FJsonClassPlan& Plan, int32 PropertyIndex, FJsonDeserializeContext& Context) {
+	if (Data == nullptr
+		||Owner == nullptr
+		|| JsonObjectProperties == nullptr)
+	{
+		return;
+	}
 
+	TSharedPtr<FJsonValue> FieldValue = JsonObjectProperties->TryGetField(Plan.PropertyNames[PropertyIndex]);
+	if (Plan.Migrations.Num() > 0 && Plan.Migrations[PropertyIndex].Num() > 0) {
+		FieldValue = MigrateFieldValue(MoveTemp(FieldValue), [&JsonObjectProperties](const FString& Key) { return JsonObjectProperties->TryGetField(Key); }, Plan.Migrations[PropertyIndex]);
+	}
+	if (!FieldValue.IsValid()) return;
 
-bool HasObjectFields(TSharedPtr<FJsonObject> JsonObject)
-{
-	return /*JsonObject->HasField(FJsonSerializationModule::ObjectNameField.ToString())
-		&& */JsonObject->HasField(FJsonSerializerFields::ObjectClassField.ToString())
-		&& JsonObject->HasField(FJsonSerializerFields::ObjectPropertiesField.ToString());
+	const FPropertyTest& TestProperty = Plan.PropertyTests[PropertyIndex];
+	DeserializePropertyFromJsonValue(TestProperty.Raw->ContainerPtrToValuePtr<void>(Data), Owner, FieldValue, TestProperty, Context);
 }
 
-static void DeserializeStructPropertyFromJsonObjectField(void* FieldData, UObject* Owner, TSharedPtr<FJsonObject> JsonStructField, FStructProperty* StructProperty, bool bIncludeObjectClasses)
+// Reads keyed properties in the same plan order the serializer writes them, then any unwritten ones the body has
+static void DeserializePropertiesFromJsonObject(void* Data, UObject* Owner, TSharedPtr<FJsonObject> JsonObjectProperties, const UStruct* Struct, FJsonDeserializeContext& Context)
 {
-	if (StructProperty->Struct == TBaseStructure<FInstancedStruct>::Get())
+	TSharedRef<const FJsonClassPlan> Plan = FJsonClassPlan::Get(Struct);
+	for (int32 i = 0; i < Plan->Properties.Num(); ++i)
 	{
-		FInstancedStruct& InstancedStruct = *(FInstancedStruct*)FieldData;
-		for (TFieldIterator<FProperty> PropertyItr(InstancedStruct.GetScriptStruct()); PropertyItr; ++PropertyItr)
-		{
-			DeserializePropertyFromJsonObjectField(InstancedStruct.GetMutableMemory(), Owner, JsonStructField, *PropertyItr, bIncludeObjectClasses);
-		}
+		DeserializePropertyFromJsonObjectField(Data, Owner, JsonObjectProperties, *Plan, i, Context);
 	}
-	else
+
+	if (Data == nullptr || Owner == nullptr || JsonObjectProperties == nullptr) return;
+
+	for (int32 i = 0; i < Plan->UnwrittenPropertyTests.Num(); ++i)
 	{
-		for (TFieldIterator<FProperty> PropertyItr(StructProperty->Struct); PropertyItr; ++PropertyItr)
-		{
-			DeserializePropertyFromJsonObjectField((void*)FieldData, Owner, JsonStructField, *PropertyItr, bIncludeObjectClasses);
-		}
+		TSharedPtr<FJsonValue> FieldValue = JsonObjectProperties->TryGetField(Plan->UnwrittenPropertyNames[i]);
+		if (!FieldValue.IsValid()) continue;
+
+		const FPropertyTest& TestProperty = Plan->UnwrittenPropertyTests[i];
+		DeserializePropertyFromJsonValue(TestProperty.Raw->ContainerPtrToValuePtr<void>(Data), Owner, FieldValue, TestProperty, Context);
 	}
 }
 
+// Rebuilds a keyed properties object from a positional body using the writer's schema table
+static TSharedPtr<FJsonObject> MakeKeyedPropertiesFromSchema(const TArray<TSharedPtr<FJsonValue>>& Values, const FString& Fingerprint, const FJsonDeserializeContext& Context)
+{
+	const TArray<TSharedPtr<FJsonValue>>* Names = nullptr;
+	if (!Context.Schemas.IsValid()
+		|| !Context.Schemas->TryGetArrayField(Fingerprint, Names)
+		|| Names->Num() != Values.Num())
+	{
+		return nullptr;
+	}
 
-static void DeserializeArrayPropertyFromJsonObjectField(void* FieldData, UObject* Owner, TArray<TSharedPtr<FJsonValue>> JsonArrayField, FArrayProperty* ArrayProperty, bool bIncludeObjectClasses) {
-	if (FieldData == nullptr
-		|| Owner == nullptr
-		|| ArrayProperty == nullptr)
+	TSharedPtr<FJsonObject> JsonObjectProperties = MakeShared<FJsonObject>();
+	JsonObjectProperties->Values.Reserve(Values.Num());
+	for (int32 i = 0; i < Values.Num(); ++i)
 	{
-		return;
+		JsonObjectProperties->SetField((*Names)[i]->AsString(), Values[i]);
 	}
+	return JsonObjectProperties;
+}
 
+static void DeserializeObjectFromJsonObject(UObject*& Object, TSharedPtr<FJsonObject> JsonObject, FJsonDeserializeContext& Context)
+{
+	if (!JsonObject.IsValid() || (Object == nullptr && !Context.bIncludeObjectClasses)) return;
 
-	FScriptArrayHelper Helper(ArrayProperty, FieldData);
-	Helper.Resize(0);
-	Helper.AddValues(JsonArrayField.Num());
+	TSharedPtr<FJsonObject> JsonObjectProperties = JsonObject;
+	const TArray<TSharedPtr<FJsonValue>>* PositionalValues = nullptr;
+	FString Fingerprint;
 
-	FPropertyTest TestProperty = FPropertyTest(ArrayProperty->Inner);
+	if (Context.bIncludeObjectClasses) {
+		const FString PropertiesField = FJsonSerializerFields::ObjectPropertiesField.ToString();
+		if (JsonObject->TryGetStringField(FJsonSerializerFields::ObjectSchemaField.ToString(), Fingerprint)) {
+			if (!JsonObject->TryGetArrayField(PropertiesField, PositionalValues)) return;
+		}
+		else {
+			if (!JsonObject->HasTypedField<EJson::Object>(PropertiesField)) return;
+			JsonObjectProperties = JsonObject->GetObjectField(PropertiesField);
+		}
 
-	for (int32 i = 0, n = Helper.Num(); i < n; ++i) {
+		FString ClassPathName = JsonObject->GetStringField(FJsonSerializerFields::ObjectClassField.ToString());
+		UClass* ObjectClass = StaticLoadClass(UObject::StaticClass(), nullptr, *ClassPathName);
 
-		TSharedPtr<FJsonValue> FieldValue = JsonArrayField[i];
-		void* InnerPropData = Helper.GetRawPtr(i);
+		if (ObjectClass != nullptr && (Object == nullptr || Object->GetClass() == ObjectClass)) {
 
-		if (TestProperty.AsArray) {
-			if (FieldValue->Type != EJson::Array) continue;
+			Object = NewObject<UObject>(GetTransientPackage(), ObjectClass);
 
-			DeserializeArrayPropertyFromJsonObjectField(InnerPropData, Owner, FieldValue->AsArray(), TestProperty.AsArray, bIncludeObjectClasses);
+			if (Object == nullptr) return;
 		}
-		if (TestProperty.AsSet) {
-			if (FieldValue->Type != EJson::Array) continue;
+	}
 
-			DeserializeSetPropertyFromJsonObjectField(InnerPropData, Owner, FieldValue->AsArray(), TestProperty.AsSet, bIncludeObjectClasses);
-		}
-		if (TestProperty.AsMap) {
-			if (FieldValue->Type != EJson::Array) continue;
+	if (Object == nullptr) return;
 
-			DeserializeMapPropertyFromJsonObjectField(InnerPropData, Owner, FieldValue->AsArray(), TestProperty.AsMap, bIncludeObjectClasses);
-		}
-		else if (TestProperty.AsStruct) {
-			if (FieldValue->Type != EJson::Object) continue;
-			DeserializeStructPropertyFromJsonObjectField(InnerPropData, Owner, FieldValue->AsObject(), TestProperty.AsStruct, bIncludeObjectClasses);
+	if (PositionalValues) {
+		TSharedRef<const FJsonClassPlan> Plan = FJsonClassPlan::Get(Object->GetClass());
+		if (Fingerprint == Plan->Fingerprint && PositionalValues->Num() == Plan->Properties.Num()) {
+			// Same layout as the writer, assign by index
+			for (int32 i = 0; i < Plan->Properties.Num(); ++i)
+			{
+				const FPropertyTest& TestProperty = Plan->PropertyTests[i];
+				DeserializePropertyFromJsonValue(TestProperty.Raw->ContainerPtrToValuePtr<void>(Object), Object, (*PositionalValues)[i], TestProperty, Context);
+			}
+			return;
 		}
-		else if (TestProperty.AsObject) {
-			if (FieldValue->Type != EJson::Object && FieldValue->Type == EJson::String) continue;
 
-			UObject* SubObject = (UObject*)InnerPropData;
-			bool bIsSubObjectToImport = FieldValue->Type == EJson::Object;
+		JsonObjectProperties = MakeKeyedPropertiesFromSchema(*PositionalValues, Fingerprint, Context);
+		if (!JsonObjectProperties.IsValid()) return;
+	}
 
-			if (bIsSubObjectToImport) {
-				FJsonSerializationModule::DeserializeJsonToUObject(SubObject, FieldValue->AsObject(), bIncludeObjectClasses);
-			}
-			else if (FieldValue->Type == EJson::String) {
-				FString ObjectPathName = FieldValue->AsString();
-				SubObject = StaticLoadObject(UObject::StaticClass(), nullptr, *ObjectPathName);
-			}
+	DeserializePropertiesFromJsonObject(Object, Object, JsonObjectProperties, Object->GetClass(), Context);
+}
 
-			if (SubObject != nullptr && bIsSubObjectToImport) {
-				SubObject->Rename(nullptr, Owner);
-			}
+void FJsonSerializationModule::DeserializeJsonToUObject(UObject*& Object, TSharedPtr<FJsonObject> JsonObject, bool bIncludeObjectClasses)
+{
+	if (!JsonObject.IsValid()) return;
 
-			TestProperty.AsObject->SetPropertyValue(InnerPropData, SubObject);
-		}
-		else {
+	FJsonDeserializeContext Context;
+	Context.bIncludeObjectClasses = bIncludeObjectClasses;
 
-			FJsonObjectConverter::JsonValueToUProperty(FieldValue, TestProperty.Raw, InnerPropData);
-		}
+	const TSharedPtr<FJsonObject>* Schemas = nullptr;
+	if (JsonObject->TryGetObjectField(FJsonSerializerFields::SchemasField.ToString(), Schemas)) {
+		Context.Schemas = *Schemas;
 	}
 
-
+	DeserializeObjectFromJsonObject(Object, JsonObject, Context);
 }
 
-static void DeserializeSetPropertyFromJsonObjectField(void* FieldData, UObject* Owner, TArray<TSharedPtr<FJsonValue>> JsonArrayField, FSetProperty* SetProperty, bool bIncludeObjectClasses) {
-	if (FieldData == nullptr
-		|| Owner == nullptr
-		|| SetProperty == nullptr)
+TSharedPtr<FJsonObject> FJsonSerializationModule::ParseUtf8Json(TArrayView<const uint8> Utf8Json)
+{
+	FJsonTape Tape;
+	if (!Tape.Parse(Utf8Json))
 	{
-		return;
+		UE_LOG(LogJsonSerialization, Warning, TEXT("Failed to parse json: %s"), *Tape.Error);
+		return nullptr;
 	}
 
+	TSharedPtr<FJsonObject> JsonObject = Tape.ToJsonObject();
+	if (!JsonObject.IsValid())
+	{
+		UE_LOG(LogJsonSerialization, Warning, TEXT("Failed to parse json: the root value is not an object"));
+	}
+	return JsonObject;
+}
 
-	FScriptSetHelper Helper(SetProperty, FieldData);
-	Helper.EmptyElements(JsonArrayField.Num());
-	FPropertyTest TestProperty = FPropertyTest(SetProperty->ElementProp);
-
-	for (int32 i = 0, n = JsonArrayField.Num(); i < n; ++i) {
-
-		TSharedPtr<FJsonValue> FieldValue = JsonArrayField[i];
+// TAPE DESERIALIZATION
 
-		int32 NewIndex = Helper.AddDefaultValue_Invalid_NeedsRehash();
-		void* InnerPropData = Helper.GetElementPtr(NewIndex);
+// Reads straight from the parsed tape, mirroring the DOM functions above. FJsonValues are only built for leaves the
+// leaf codec doesn't handle, which go to FJsonObjectConverter, and for properties with migrations
 
-		if (TestProperty.AsArray) {
-			if (FieldValue->Type != EJson::Array) continue;
+// Field names and value indices of an object body: a keyed object's fields, or a positional body's values with the
+// names from the writer's schema table
+using FJsonTapeFields = TArray<TPair<FStringView, int32>, TInlineAllocator<64>>;
 
-			DeserializeArrayPropertyFromJsonObjectField(InnerPropData, Owner, FieldValue->AsArray(), TestProperty.AsArray, bIncludeObjectClasses);
-		}
-		if (TestProperty.AsSet) {
-			if (FieldValue->Type != EJson::Array) continue;
+static void DeserializePropertyFromTape(void* ValueData, UObject* Owner, int32 Index, const FPropertyTest& TestProperty, FJsonDeserializeContext& Context);
+static void DeserializePropertiesFromTape(void* Data, UObject* Owner, int32 ObjectIndex, const UStruct* Struct, FJsonDeserializeContext& Context);
+static void DeserializeObjectFromTape(UObject*& Object, int32 Index, FJsonDeserializeContext& Context);
 
-			DeserializeSetPropertyFromJsonObjectField(InnerPropData, Owner, FieldValue->AsArray(), TestProperty.AsSet, bIncludeObjectClasses);
-		}
-		if (TestProperty.AsMap) {
-			if (FieldValue->Type != EJson::Array) continue;
+static void DeserializeArrayPropertyFromTape(void* FieldData, UObject* Owner, int32 Index, FArrayProperty* ArrayProperty, FJsonDeserializeContext& Context)
+{
+	if (FieldData == nullptr || Owner == nullptr) return;
 
-			DeserializeMapPropertyFromJsonObjectField(InnerPropData, Owner, FieldValue->AsArray(), TestProperty.AsMap, bIncludeObjectClasses);
-		}
-		else if (TestProperty.AsStruct) {
-			if (FieldValue->Type != EJson::Object) continue;
-			DeserializeStructPropertyFromJsonObjectField(InnerPropData, Owner, FieldValue->AsObject(), TestProperty.AsStruct, bIncludeObjectClasses);
-		}
-		else if (TestProperty.AsObject) {
-			if (FieldValue->Type != EJson::Object && FieldValue->Type == EJson::String) continue;
+	const FJsonTape& Tape = *Context.Tape;
+	FScriptArrayHelper Helper(ArrayProperty, FieldData);
+	Helper.Resize(0);
+	Helper.AddValues(Tape.GetCount(Index));
 
-			UObject* SubObject = (UObject*)InnerPropData;
-			bool bIsSubObjectToImport = FieldValue->Type == EJson::Object;
+	FPropertyTest TestProperty = FPropertyTest(ArrayProperty->Inner);
 
-			if (bIsSubObjectToImport) {
-				FJsonSerializationModule::DeserializeJsonToUObject(SubObject, FieldValue->AsObject(), bIncludeObjectClasses);
-			}
-			else if (FieldValue->Type == EJson::String) {
-				FString ObjectPathName = FieldValue->AsString();
-				SubObject = StaticLoadObject(UObject::StaticClass(), nullptr, *ObjectPathName);
-			}
+	int32 ElementIndex = Index + 1;
+	for (int32 i = 0, n = Helper.Num(); i < n; ++i, ElementIndex = Tape.Next(ElementIndex)) {
+		DeserializePropertyFromTape(Helper.GetRawPtr(i), Owner, ElementIndex, TestProperty, Context);
+	}
+}
 
-			if (SubObject != nullptr && bIsSubObjectToImport) {
-				SubObject->Rename(nullptr, Owner);
-			}
+static void DeserializeSetPropertyFromTape(void* FieldData, UObject* Owner, int32 Index, FSetProperty* SetProperty, FJsonDeserializeContext& Context)
+{
+	if (FieldData == nullptr || Owner == nullptr) return;
 
-			TestProperty.AsObject->SetPropertyValue(InnerPropData, SubObject);
-		}
-		else {
+	const FJsonTape& Tape = *Context.Tape;
+	FScriptSetHelper Helper(SetProperty, FieldData);
+	Helper.EmptyElements(Tape.GetCount(Index));
+	FPropertyTest TestProperty = FPropertyTest(SetProperty->ElementProp);
 
-			FJsonObjectConverter::JsonValueToUProperty(FieldValue, TestProperty.Raw, InnerPropData);
-		}
+	for (int32 ElementIndex = Index + 1; Tape.GetType(ElementIndex) != FJsonTape::EType::ArrayEnd; ElementIndex = Tape.Next(ElementIndex)) {
+		int32 NewIndex = Helper.AddDefaultValue_Invalid_NeedsRehash();
+		DeserializePropertyFromTape(Helper.GetElementPtr(NewIndex), Owner, ElementIndex, TestProperty, Context);
 	}
 
 	Helper.Rehash();
 }
 
-void DeserializeMapPropertyFromJsonObjectField(void* FieldData, UObject* Owner, TArray<TSharedPtr<FJsonValue>> JsonArrayField, FMapProperty* MapProperty, bool bIncludeObjectClasses)
+static void DeserializeMapPropertyFromTapeArray(void* FieldData, UObject* Owner, int32 Index, FMapProperty* MapProperty, FJsonDeserializeContext& Context)
 {
-	if (FieldData == nullptr
-		|| Owner == nullptr
-		|| MapProperty == nullptr)
-	{
-		return;
-	}
-
+	if (FieldData == nullptr || Owner == nullptr) return;
 
+	const FJsonTape& Tape = *Context.Tape;
 	FScriptMapHelper Helper(MapProperty, FieldData);
-	Helper.EmptyValues(JsonArrayField.Num());
+	Helper.EmptyValues(Tape.GetCount(Index));
 
 	FPropertyTest TestKey = FPropertyTest(Helper.KeyProp);
 	FPropertyTest TestValue = FPropertyTest(Helper.ValueProp);
 
-	for (int32 i = 0, n = JsonArrayField.Num(); i < n; ++i) {
-
-		TSharedPtr<FJsonValue> FieldValue = JsonArrayField[i];
-
-		if (FieldValue->Type != EJson::Object) continue;
+	for (int32 EntryIndex = Index + 1; Tape.GetType(EntryIndex) != FJsonTape::EType::ArrayEnd; EntryIndex = Tape.Next(EntryIndex)) {
+		if (Tape.GetType(EntryIndex) != FJsonTape::EType::ObjectStart) continue;
 
-		TSharedPtr<FJsonObject> KeyValObject = FieldValue->AsObject();
-		TSharedPtr<FJsonValue> KeyValue = KeyValObject->GetField<EJson::None>("Key");
-		TSharedPtr<FJsonValue> ValValue = KeyValObject->GetField<EJson::None>("Value");
+		const int32 KeyIndex = Tape.FindField(EntryIndex, TEXT("Key"));
+		const int32 ValueIndex = Tape.FindField(EntryIndex, TEXT("Value"));
+		if (KeyIndex == INDEX_NONE || ValueIndex == INDEX_NONE) continue;
 
 		int32 NewIndex = Helper.AddDefaultValue_Invalid_NeedsRehash();
-		void* KeyData = Helper.GetKeyPtr(NewIndex);
-		void* ValueData = Helper.GetValuePtr(NewIndex);
-
-		if (TestKey.AsArray) {
-			if (KeyValue->Type != EJson::Array) continue;
-
-			DeserializeArrayPropertyFromJsonObjectField(KeyData, Owner, KeyValue->AsArray(), TestKey.AsArray, bIncludeObjectClasses);
-		}
-		if (TestKey.AsSet) {
-			if (KeyValue->Type != EJson::Array) continue;
+		DeserializePropertyFromTape(Helper.GetKeyPtr(NewIndex), Owner, KeyIndex, TestKey, Context);
+		DeserializePropertyFromTape(Helper.GetValuePtr(NewIndex), Owner, ValueIndex, TestValue, Context);
+	}
 
-			DeserializeSetPropertyFromJsonObjectField(KeyData, Owner, KeyValue->AsArray(), TestKey.AsSet, bIncludeObjectClasses);
-		}
-		if (TestKey.AsMap) {
-			if (KeyValue->Type != EJson::Array) continue;
+	Helper.Rehash();
+}
 
-			DeserializeMapPropertyFromJsonObjectField(KeyData, Owner, KeyValue->AsArray(), TestKey.AsMap, bIncludeObjectClasses);
-		}
-		else if (TestKey.AsStruct) {
-			if (KeyValue->Type != EJson::Object) continue;
-			DeserializeStructPropertyFromJsonObjectField(KeyData, Owner, KeyValue->AsObject(), TestKey.AsStruct, bIncludeObjectClasses);
-		}
-		else if (TestKey.AsObject) {
-			if (KeyValue->Type != EJson::Object && KeyValue->Type != EJson::String) continue;
+static void DeserializeMapPropertyFromTapeObject(void* FieldData, UObject* Owner, int32 Index, FMapProperty* MapProperty, FJsonDeserializeContext& Context)
+{
+	if (FieldData == nullptr || Owner == nullptr || !IsStringLikeMapKey(MapProperty->KeyProp)) return;
 
-			UObject* SubObject = (UObject*)KeyData;
-			bool bIsSubObjectToImport = KeyValue->Type == EJson::Object;
+	const FJsonTape& Tape = *Context.Tape;
+	FScriptMapHelper Helper(MapProperty, FieldData);
+	Helper.EmptyValues(Tape.GetCount(Index));
 
-			if (bIsSubObjectToImport) {
-				FJsonSerializationModule::DeserializeJsonToUObject(SubObject, KeyValue->AsObject(), bIncludeObjectClasses);
-			}
-			else if (KeyValue->Type == EJson::String) {
-				FString ObjectPathName = KeyValue->AsString();
-				SubObject = StaticLoadObject(UObject::StaticClass(), nullptr, *ObjectPathName);
-			}
+	FPropertyTest TestValue = FPropertyTest(Helper.ValueProp);
 
-			if (SubObject != nullptr && bIsSubObjectToImport) {
-				SubObject->Rename(nullptr, Owner);
-			}
+	// Unlike an FJsonObject, the tape keeps duplicate keys, so the map is looked up instead of appended to blindly
+	FProperty* KeyProp = Helper.KeyProp;
+	void* KeyData = FMemory::Malloc(KeyProp->GetSize(), KeyProp->GetMinAlignment());
+	KeyProp->InitializeValue(KeyData);
 
-			TestKey.AsObject->SetPropertyValue(KeyData, SubObject);
-		}
-		else {
+	for (int32 KeyIndex = Index + 1; Tape.GetType(KeyIndex) != FJsonTape::EType::ObjectEnd; KeyIndex = Tape.Next(KeyIndex + 1)) {
+		MapKeyFromString(KeyProp, KeyData, FString(Tape.GetString(KeyIndex)));
+		DeserializePropertyFromTape(Helper.FindOrAdd(KeyData), Owner, KeyIndex + 1, TestValue, Context);
+	}
 
-			FJsonObjectConverter::JsonValueToUProperty(KeyValue, TestKey.Raw, KeyData);
-		}
+	KeyProp->DestroyValue(KeyData);
+	FMemory::Free(KeyData);
+}
 
+static void DeserializeStructPropertyFromTape(void* FieldData, UObject* Owner, int32 Index, FStructProperty* StructProperty, FJsonDeserializeContext& Context)
+{
+	if (StructProperty->Struct == TBaseStructure<FInstancedStruct>::Get())
+	{
+		FInstancedStruct& InstancedStruct = *(FInstancedStruct*)FieldData;
+		if (InstancedStruct.GetScriptStruct() == nullptr) return;
 
-		if (TestValue.AsArray) {
-			if (ValValue->Type != EJson::Array) continue;
+		DeserializePropertiesFromTape(InstancedStruct.GetMutableMemory(), Owner, Index, InstancedStruct.GetScriptStruct(), Context);
+	}
+	else
+	{
+		DeserializePropertiesFromTape(FieldData, Owner, Index, StructProperty->Struct, Context);
+	}
+}
 
-			DeserializeArrayPropertyFromJsonObjectField(ValueData, Owner, ValValue->AsArray(), TestValue.AsArray, bIncludeObjectClasses);
-		}
-		if (TestValue.AsSet) {
-			if (ValValue->Type != EJson::Array) continue;
+static void DeserializeObjectPropertyFromTape(void* FieldData, UObject* Owner, int32 Index, FObjectProperty* ObjectProperty, FJsonDeserializeContext& Context)
+{
+	const FJsonTape& Tape = *Context.Tape;
+	UObject* SubObject = ObjectProperty->GetObjectPropertyValue(FieldData);
+	bool bIsSubObjectToImport = Tape.GetType(Index) == FJsonTape::EType::ObjectStart;
 
-			DeserializeSetPropertyFromJsonObjectField(ValueData, Owner, ValValue->AsArray(), TestValue.AsSet, bIncludeObjectClasses);
-		}
-		if (TestValue.AsMap) {
-			if (ValValue->Type != EJson::Array) continue;
+	if (bIsSubObjectToImport) {
+		DeserializeObjectFromTape(SubObject, Index, Context);
+	}
+	else if (Tape.GetType(Index) == FJsonTape::EType::String) {
+		FString ObjectPathName(Tape.GetString(Index));
+		SubObject = StaticLoadObject(UObject::StaticClass(), nullptr, *ObjectPathName);
+	}
+	else {
+		return;
+	}
 
-			DeserializeMapPropertyFromJsonObjectField(ValueData, Owner, ValValue->AsArray(), TestValue.AsMap, bIncludeObjectClasses);
-		}
-		else if (TestValue.AsStruct) {
-			if (ValValue->Type != EJson::Object) continue;
-			DeserializeStructPropertyFromJsonObjectField(ValueData, Owner, ValValue->AsObject(), TestValue.AsStruct, bIncludeObjectClasses);
-		}
-		else if (TestValue.AsObject) {
-			if (ValValue->Type != EJson::Object && ValValue->Type != EJson::String) continue;
+	if (SubObject != nullptr && bIsSubObjectToImport) {
+		SubObject->Rename(nullptr, Owner);
+	}
 
-			UObject* SubObject = (UObject*)ValueData;
-			bool bIsSubObjectToImport = ValValue->Type == EJson::Object;
+	ObjectProperty->SetObjectPropertyValue(FieldData, SubObject);
+}
 
-			if (bIsSubObjectToImport) {
-				FJsonSerializationModule::DeserializeJsonToUObject(SubObject, ValValue->AsObject(), bIncludeObjectClasses);
-			}
-			else if (ValValue->Type == EJson::String) {
-				FString ObjectPathName = ValValue->AsString();
-				SubObject = StaticLoadObject(UObject::StaticClass(), nullptr, *ObjectPathName);
-			}
+static bool DecodeLeafFromTape(int32 Index, const FPropertyTest& TestProperty, void* ValueData, const FJsonTape& Tape)
+{
+	switch (Tape.GetType(Index))
+	{
+	case FJsonTape::EType::True:
+	case FJsonTape::EType::False:
+		return FJsonLeafCodec::DecodeBool(TestProperty.Leaf, TestProperty.Raw, Tape.GetType(Index) == FJsonTape::EType::True, ValueData);
+	case FJsonTape::EType::Number:
+		return FJsonLeafCodec::DecodeNumber(TestProperty.Leaf, TestProperty.Raw, Tape.GetNumber(Index), ValueData);
+	case FJsonTape::EType::String:
+		return FJsonLeafCodec::DecodeString(TestProperty.Leaf, TestProperty.Raw, Tape.GetString(Index), ValueData);
+	default:
+		return false;
+	}
+}
 
-			if (SubObject != nullptr && bIsSubObjectToImport) {
-				SubObject->Rename(nullptr, Owner);
-			}
+static void DeserializePropertyFromTape(void* ValueData, UObject* Owner, int32 Index, const FPropertyTest& TestProperty, FJsonDeserializeContext& Context)
+{
+	const FJsonTape& Tape = *Context.Tape;
+	const FJsonTape::EType Type = Tape.GetType(Index);
 
-			TestValue.AsObject->SetPropertyValue(ValueData, SubObject);
+	if (TestProperty.AsArray) {
+		if (Type != FJsonTape::EType::ArrayStart) return;
+		DeserializeArrayPropertyFromTape(ValueData, Owner, Index, TestProperty.AsArray, Context);
+	}
+	else if (TestProperty.AsSet) {
+		if (Type != FJsonTape::EType::ArrayStart) return;
+		DeserializeSetPropertyFromTape(ValueData, Owner, Index, TestProperty.AsSet, Context);
+	}
+	else if (TestProperty.AsMap) {
+		if (Type == FJsonTape::EType::ObjectStart) {
+			DeserializeMapPropertyFromTapeObject(ValueData, Owner, Index, TestProperty.AsMap, Context);
 		}
-		else {
-
-			FJsonObjectConverter::JsonValueToUProperty(ValValue, TestValue.Raw, ValueData);
+		else if (Type == FJsonTape::EType::ArrayStart) {
+			DeserializeMapPropertyFromTapeArray(ValueData, Owner, Index, TestProperty.AsMap, Context);
 		}
 	}
-
-	Helper.Rehash();
+	else if (TestProperty.AsStruct) {
+		if (Type != FJsonTape::EType::ObjectStart) return;
+		DeserializeStructPropertyFromTape(ValueData, Owner, Index, TestProperty.AsStruct, Context);
+	}
+	else if (TestProperty.AsObject) {
+		DeserializeObjectPropertyFromTape(ValueData, Owner, Index, TestProperty.AsObject, Context);
+	}
+	else if (TestProperty.Leaf == EJsonLeafType::None || !DecodeLeafFromTape(Index, TestProperty, ValueData, Tape)) {
+		FJsonObjectConverter::JsonValueToUProperty(Tape.ToJsonValue(Index), TestProperty.Raw, ValueData);
+	}
 }
 
-static void DeserializePropertyFromJsonObjectField(void* Data, UObject* Owner, TSharedPtr<FJsonObject> JsonObjectProperties, FProperty* Property, bool bIncludeObjectClasses) {
-	if (Data == nullptr
-		||Owner == nullptr
-		|| JsonObjectProperties == nullptr
-		|| Property == nullptr) 
+// Index of the plan property named Key, ignoring case like FJsonObject. Fields usually come in plan order, so the
+// search starts at the property after the last one found
+static int32 FindPlanProperty(const FJsonClassPlan& Plan, FStringView Key, int32 StartIndex)
+{
+	const int32 NumProperties = Plan.PropertyNames.Num();
+	for (int32 Offset = 0; Offset < NumProperties; ++Offset)
 	{
-		return;
+		const int32 PropertyIndex = (StartIndex + Offset) % NumProperties;
+		if (Key.Equals(Plan.PropertyNames[PropertyIndex], ESearchCase::IgnoreCase))
+		{
+			return PropertyIndex;
+		}
 	}
+	return INDEX_NONE;
+}
 
-	FPropertyTest TestProperty = FPropertyTest(Property);
-
-	const FString PropertyName = Property->GetAuthoredName();
+static void DeserializePropertiesFromTapeFields(void* Data, UObject* Owner, const FJsonTapeFields& Fields, const FJsonClassPlan& Plan, FJsonDeserializeContext& Context)
+{
+	if (Data == nullptr || Owner == nullptr) return;
 
-	if (!JsonObjectProperties->HasField(PropertyName)) return;
+	const FJsonTape& Tape = *Context.Tape;
 
-	TSharedPtr<FJsonValue> FieldValue = JsonObjectProperties->GetField<EJson::None>(PropertyName);
-	void* FieldData = Property->ContainerPtrToValuePtr<void>(Data);
+	// The last of duplicate keys wins, as in an FJsonObject
+	TArray<int32, TInlineAllocator<64>> ValueIndices;
+	TArray<int32, TInlineAllocator<8>> UnwrittenValueIndices;
+	ValueIndices.Init(INDEX_NONE, Plan.Properties.Num());
+	UnwrittenValueIndices.Init(INDEX_NONE, Plan.UnwrittenPropertyTests.Num());
+	int32 NextProperty = 0;
+	for (const TPair<FStringView, int32>& Field : Fields)
+	{
+		const int32 PropertyIndex = FindPlanProperty(Plan, Field.Key, NextProperty);
+		if (PropertyIndex != INDEX_NONE)
+		{
+			ValueIndices[PropertyIndex] = Field.Value;
+			NextProperty = PropertyIndex + 1;
+			continue;
+		}
 
-	if (TestProperty.AsArray){
-		if (FieldValue->Type == EJson::Array) {
-			TArray<TSharedPtr<FJsonValue>> ArrayJson = FieldValue->AsArray();
-			DeserializeArrayPropertyFromJsonObjectField(FieldData, Owner, ArrayJson, TestProperty.AsArray, bIncludeObjectClasses);
+		const int32 UnwrittenIndex = Plan.UnwrittenPropertyNames.IndexOfByPredicate([&Field](const FString& Name) { return Field.Key.Equals(Name, ESearchCase::IgnoreCase); });
+		if (UnwrittenIndex != INDEX_NONE)
+		{
+			UnwrittenValueIndices[UnwrittenIndex] = Field.Value;
 		}
 	}
-	if (TestProperty.AsSet) {
-		if (FieldValue->Type == EJson::Array) {
-			TArray<TSharedPtr<FJsonValue>> ArrayJson = FieldValue->AsArray();
-			DeserializeSetPropertyFromJsonObjectField(FieldData, Owner, ArrayJson, TestProperty.AsSet, bIncludeObjectClasses);
+
+	for (int32 i = 0; i < Plan.Properties.Num(); ++i)
+	{
+		const FPropertyTest& TestProperty = Plan.PropertyTests[i];
+		void* ValueData = TestProperty.Raw->ContainerPtrToValuePtr<void>(Data);
+
+		if (Plan.Migrations.Num() > 0 && Plan.Migrations[i].Num() > 0) {
+			// Converters take json values, so migrated properties go through the DOM path
+			auto FindField = [&Fields, &Tape](const FString& Key) -> TSharedPtr<FJsonValue>
+			{
+				for (int32 FieldIndex = Fields.Num() - 1; FieldIndex >= 0; --FieldIndex)
+				{
+					if (Fields[FieldIndex].Key.Equals(Key, ESearchCase::IgnoreCase)) return Tape.ToJsonValue(Fields[FieldIndex].Value);
+				}
+				return nullptr;
+			};
+
+			TSharedPtr<FJsonValue> FieldValue = ValueIndices[i] != INDEX_NONE ? Tape.ToJsonValue(ValueIndices[i]) : nullptr;
+			FieldValue = MigrateFieldValue(MoveTemp(FieldValue), FindField, Plan.Migrations[i]);
+			if (FieldValue.IsValid()) {
+				DeserializePropertyFromJsonValue(ValueData, Owner, FieldValue, TestProperty, Context);
+			}
 		}
-	}
-	if (TestProperty.AsMap) {
-		if (FieldValue->Type == EJson::Array) {
-			TArray<TSharedPtr<FJsonValue>> ArrayJson = FieldValue->AsArray();
-			DeserializeMapPropertyFromJsonObjectField(FieldData, Owner, ArrayJson, TestProperty.AsMap, bIncludeObjectClasses);
+		else if (ValueIndices[i] != INDEX_NONE) {
+			DeserializePropertyFromTape(ValueData, Owner, ValueIndices[i], TestProperty, Context);
 		}
 	}
-	else if (TestProperty.AsStruct) {
-		if (FieldValue->Type != EJson::Object) return;
-		DeserializeStructPropertyFromJsonObjectField(FieldData, Owner, FieldValue->AsObject(), TestProperty.AsStruct, bIncludeObjectClasses);
+
+	for (int32 i = 0; i < Plan.UnwrittenPropertyTests.Num(); ++i)
+	{
+		if (UnwrittenValueIndices[i] == INDEX_NONE) continue;
+
+		const FPropertyTest& TestProperty = Plan.UnwrittenPropertyTests[i];
+		DeserializePropertyFromTape(TestProperty.Raw->ContainerPtrToValuePtr<void>(Data), Owner, UnwrittenValueIndices[i], TestProperty, Context);
 	}
-	else if (TestProperty.AsObject) {
-		UObject* SubObject = (UObject*)FieldData;
+}
+
+static void DeserializePropertiesFromTape(void* Data, UObject* Owner, int32 ObjectIndex, const UStruct* Struct, FJsonDeserializeContext& Context)
+{
+	const FJsonTape& Tape = *Context.Tape;
 
-		bool bIsSubObjectToImport = FieldValue->Type == EJson::Object;
+	FJsonTapeFields Fields;
+	for (int32 KeyIndex = ObjectIndex + 1; Tape.GetType(KeyIndex) != FJsonTape::EType::ObjectEnd; KeyIndex = Tape.Next(KeyIndex + 1))
+	{
+		Fields.Emplace(Tape.GetString(KeyIndex), KeyIndex + 1);
+	}
 
-		if (bIsSubObjectToImport) {
-			FJsonSerializationModule::DeserializeJsonToUObject(SubObject, FieldValue->AsObject(), bIncludeObjectClasses);
-		}
-		else if (FieldValue->Type == EJson::String){
-			FString ObjectPathName = FieldValue->AsString();
-			SubObject = StaticLoadObject(UObject::StaticClass(), nullptr, *ObjectPathName);
-		}
+	DeserializePropertiesFromTapeFields(Data, Owner, Fields, *FJsonClassPlan::Get(Struct), Context);
+}
 
-		if (SubObject != nullptr && bIsSubObjectToImport) {
-			SubObject->Rename(nullptr, Owner);
-		}
+// Names a positional body's values with the writer's schema table
+static bool GetPositionalTapeFields(int32 ValuesIndex, FStringView Fingerprint, const FJsonDeserializeContext& Context, FJsonTapeFields& OutFields)
+{
+	const FJsonTape& Tape = *Context.Tape;
+	if (Context.TapeSchemas == INDEX_NONE) return false;
 
-		TestProperty.AsObject->SetPropertyValue(FieldData, SubObject);
+	const int32 NamesIndex = Tape.FindField(Context.TapeSchemas, Fingerprint);
+	if (NamesIndex == INDEX_NONE
+		|| Tape.GetType(NamesIndex) != FJsonTape::EType::ArrayStart
+		|| Tape.GetCount(NamesIndex) != Tape.GetCount(ValuesIndex))
+	{
+		return false;
 	}
-	else {
-		
-		FJsonObjectConverter::JsonValueToUProperty(FieldValue, Property, FieldData);
+
+	int32 ValueIndex = ValuesIndex + 1;
+	for (int32 NameIndex = NamesIndex + 1; Tape.GetType(NameIndex) != FJsonTape::EType::ArrayEnd; NameIndex = Tape.Next(NameIndex), ValueIndex = Tape.Next(ValueIndex))
+	{
+		OutFields.Emplace(Tape.GetType(NameIndex) == FJsonTape::EType::String ? Tape.GetString(NameIndex) : FStringView(), ValueIndex);
 	}
+	return true;
 }
 
-void FJsonSerializationModule::DeserializeJsonToUObject(UObject*& Object, TSharedPtr<FJsonObject> JsonObject, bool bIncludeObjectClasses)
+static void DeserializeObjectFromTape(UObject*& Object, int32 Index, FJsonDeserializeContext& Context)
 {
-	if (Object == nullptr && !bIncludeObjectClasses) return;
-
-	TSharedPtr<FJsonObject> JsonObjectProperties = JsonObject;
-	if (bIncludeObjectClasses) {
-		if (!JsonObject->HasTypedField<EJson::Object>(FJsonSerializerFields::ObjectPropertiesField.ToString())) return;
-		JsonObjectProperties = JsonObject->GetObjectField(FJsonSerializerFields::ObjectPropertiesField.ToString());
+	const FJsonTape& Tape = *Context.Tape;
+	if (Tape.GetType(Index) != FJsonTape::EType::ObjectStart || (Object == nullptr && !Context.bIncludeObjectClasses)) return;
+
+	int32 PropertiesIndex = Index;
+	int32 PositionalIndex = INDEX_NONE;
+	FStringView Fingerprint;
+
+	if (Context.bIncludeObjectClasses) {
+		const int32 SchemaIndex = Tape.FindField(Index, FJsonSerializerFields::ObjectSchemaField.ToString());
+		const int32 ValuesIndex = Tape.FindField(Index, FJsonSerializerFields::ObjectPropertiesField.ToString());
+		if (SchemaIndex != INDEX_NONE && Tape.GetType(SchemaIndex) == FJsonTape::EType::String) {
+			if (ValuesIndex == INDEX_NONE || Tape.GetType(ValuesIndex) != FJsonTape::EType::ArrayStart) return;
+			Fingerprint = Tape.GetString(SchemaIndex);
+			PositionalIndex = ValuesIndex;
+		}
+		else {
+			if (ValuesIndex == INDEX_NONE || Tape.GetType(ValuesIndex) != FJsonTape::EType::ObjectStart) return;
+			PropertiesIndex = ValuesIndex;
+		}
 
-		FString ClassPathName = JsonObject->GetStringField(FJsonSerializerFields::ObjectClassField.ToString());
+		const int32 ClassIndex = Tape.FindField(Index, FJsonSerializerFields::ObjectClassField.ToString());
+		FString ClassPathName = ClassIndex != INDEX_NONE && Tape.GetType(ClassIndex) == FJsonTape::EType::String ? FString(Tape.GetString(ClassIndex)) : FString();
 		UClass* ObjectClass = StaticLoadClass(UObject::StaticClass(), nullptr, *ClassPathName);
-		
+
 		if (ObjectClass != nullptr && (Object == nullptr || Object->GetClass() == ObjectClass)) {
 
 			Object = NewObject<UObject>(GetTransientPackage(), ObjectClass);
@@ -796,12 +1575,61 @@ void FJsonSerializationModule::DeserializeJsonToUObject(UObject*& Object, TShare
 		}
 	}
 
-	for (TFieldIterator<FProperty> PropertyItr(Object->GetClass()); PropertyItr; ++PropertyItr)
+	if (Object == nullptr) return;
+
+	if (PositionalIndex != INDEX_NONE) {
+		TSharedRef<const FJsonClassPlan> Plan = FJsonClassPlan::Get(Object->GetClass());
+		if (Fingerprint.Equals(Plan->Fingerprint, ESearchCase::IgnoreCase) && Tape.GetCount(PositionalIndex) == Plan->Properties.Num()) {
+			// Same layout as the writer, assign by index
+			int32 ValueIndex = PositionalIndex + 1;
+			for (int32 i = 0; i < Plan->Properties.Num(); ++i, ValueIndex = Tape.Next(ValueIndex))
+			{
+				const FPropertyTest& TestProperty = Plan->PropertyTests[i];
+				DeserializePropertyFromTape(TestProperty.Raw->ContainerPtrToValuePtr<void>(Object), Object, ValueIndex, TestProperty, Context);
+			}
+			return;
+		}
+
+		FJsonTapeFields Fields;
+		if (!GetPositionalTapeFields(PositionalIndex, Fingerprint, Context, Fields)) return;
+
+		DeserializePropertiesFromTapeFields(Object, Object, Fields, *Plan, Context);
+		return;
+	}
+
+	DeserializePropertiesFromTape(Object, Object, PropertiesIndex, Object->GetClass(), Context);
+}
+
+bool FJsonSerializationModule::DeserializeUtf8JsonToUObject(UObject*& Object, TArrayView<const uint8> Utf8Json, bool bIncludeObjectClasses)
+{
+	FJsonTape Tape;
+	if (!Tape.Parse(Utf8Json))
 	{
-		DeserializePropertyFromJsonObjectField(Object, Object, JsonObjectProperties, *PropertyItr, bIncludeObjectClasses);
+		UE_LOG(LogJsonSerialization, Warning, TEXT("Failed to parse json: %s"), *Tape.Error);
+		return false;
 	}
+	if (Tape.GetType(0) != FJsonTape::EType::ObjectStart)
+	{
+		UE_LOG(LogJsonSerialization, Warning, TEXT("Failed to parse json: the root value is not an object"));
+		return false;
+	}
+
+	FJsonDeserializeContext Context;
+	Context.bIncludeObjectClasses = bIncludeObjectClasses;
+	Context.Tape = &Tape;
+
+	const int32 SchemasIndex = Tape.FindField(0, FJsonSerializerFields::SchemasField.ToString());
+	if (SchemasIndex != INDEX_NONE && Tape.GetType(SchemasIndex) == FJsonTape::EType::ObjectStart) {
+		Context.TapeSchemas = SchemasIndex;
+
+		// Migrated values are read through the DOM path, which may meet positional bodies too
+		Context.Schemas = Tape.ToJsonValue(SchemasIndex)->AsObject();
+	}
+
+	DeserializeObjectFromTape(Object, 0, Context);
+	return true;
 }
 
 #undef LOCTEXT_NAMESPACE
-	
-IMPLEMENT_MODULE(FJsonSerializationModule, JsonSerialization)
\ No newline at end of file
+
+IMPLEMENT_MODULE(FJsonSerializationModule, JsonSerialization)
@@ -0,0 +1,650 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "JsonTape.h"
+
+#if defined(PLATFORM_ALWAYS_HAS_AVX_2) && PLATFORM_ALWAYS_HAS_AVX_2
+#define JSON_TAPE_AVX2 (PLATFORM_ENABLE_VECTORINTRINSICS && PLATFORM_CPU_X86_FAMILY)
+#else
+#define JSON_TAPE_AVX2 0
+#endif
+#define JSON_TAPE_SSE2 (PLATFORM_ENABLE_VECTORINTRINSICS && PLATFORM_CPU_X86_FAMILY)
+
+#if JSON_TAPE_AVX2
+#include <immintrin.h>
+#elif JSON_TAPE_SSE2
+#include <emmintrin.h>
+#endif
+
+static uint64 MakeWord(FJsonTape::EType Type, uint64 Payload)
+{
+	return ((uint64)Type << 56) | Payload;
+}
+
+static FJsonTape::EType GetWordType(uint64 Word)
+{
+	return (FJsonTape::EType)(Word >> 56);
+}
+
+static uint64 GetWordPayload(uint64 Word)
+{
+	return Word & ((1ull << 56) - 1);
+}
+
+// STAGE 1
+
+// One bit per byte of a 64 byte block
+struct FJsonBlockMasks
+{
+	uint64 Quote = 0;
+	uint64 Backslash = 0;
+	uint64 Operator = 0; // { } [ ] : ,
+	uint64 Whitespace = 0;
+};
+
+static void ClassifyBlock(const uint8* Block, FJsonBlockMasks& Out)
+{
+#if JSON_TAPE_AVX2
+	for (int32 Half = 0; Half < 2; ++Half)
+	{
+		const __m256i Bytes = _mm256_loadu_si256((const __m256i*)(Block + Half * 32));
+		auto Match = [&Bytes](char Char) { return _mm256_cmpeq_epi8(Bytes, _mm256_set1_epi8(Char)); };
+		auto ToMask = [Half](__m256i Matches) { return (uint64)(uint32)_mm256_movemask_epi8(Matches) << (Half * 32); };
+
+		Out.Quote |= ToMask(Match('"'));
+		Out.Backslash |= ToMask(Match('\\'));
+		Out.Operator |= ToMask(_mm256_or_si256(_mm256_or_si256(_mm256_or_si256(Match('{'), Match('}')), _mm256_or_si256(Match('['), Match(']'))), _mm256_or_si256(Match(':'), Match(','))));
+		Out.Whitespace |= ToMask(_mm256_or_si256(_mm256_or_si256(Match(' '), Match('\t')), _mm256_or_si256(Match('\n'), Match('\r'))));
+	}
+#elif JSON_TAPE_SSE2
+	for (int32 Quarter = 0; Quarter < 4; ++Quarter)
+	{
+		const __m128i Bytes = _mm_loadu_si128((const __m128i*)(Block + Quarter * 16));
+		auto Match = [&Bytes](char Char) { return _mm_cmpeq_epi8(Bytes, _mm_set1_epi8(Char)); };
+		auto ToMask = [Quarter](__m128i Matches) { return (uint64)(uint32)_mm_movemask_epi8(Matches) << (Quarter * 16); };
+
+		Out.Quote |= ToMask(Match('"'));
+		Out.Backslash |= ToMask(Match('\\'));
+		Out.Operator |= ToMask(_mm_or_si128(_mm_or_si128(_mm_or_si128(Match('{'), Match('}')), _mm_or_si128(Match('['), Match(']'))), _mm_or_si128(Match(':'), Match(','))));
+		Out.Whitespace |= ToMask(_mm_or_si128(_mm_or_si128(Match(' '), Match('\t')), _mm_or_si128(Match('\n'), Match('\r'))));
+	}
+#else
+	for (int32 i = 0; i < 64; ++i)
+	{
+		const uint64 Bit = 1ull << i;
+		switch (Block[i])
+		{
+		case '"': Out.Quote |= Bit; break;
+		case '\\': Out.Backslash |= Bit; break;
+		case '{': case '}': case '[': case ']': case ':': case ',': Out.Operator |= Bit; break;
+		case ' ': case '\t': case '\n': case '\r': Out.Whitespace |= Bit; break;
+		default: break;
+		}
+	}
+#endif
+}
+
+// Bit i of the result is the xor of bits 0..i, which turns quote positions into string extents
+static uint64 PrefixXor(uint64 Bits)
+{
+	Bits ^= Bits << 1;
+	Bits ^= Bits << 2;
+	Bits ^= Bits << 4;
+	Bits ^= Bits << 8;
+	Bits ^= Bits << 16;
+	Bits ^= Bits << 32;
+	return Bits;
+}
+
+// STAGE 2
+
+struct FJsonTapeParser
+{
+	static constexpr int32 MaxDepth = 1024;
+
+	FJsonTape& Tape;
+	const uint8* Text;
+	int32 Len;
+
+	// Offsets of structural characters, opening quotes and the first byte of numbers and literals
+	TArray<int32> Structurals;
+	int32 Cursor = 0;
+
+	FJsonTapeParser(FJsonTape& InTape, TArrayView<const uint8> Utf8Json)
+		: Tape(InTape)
+		, Text(Utf8Json.GetData())
+		, Len(Utf8Json.Num())
+	{
+	}
+
+	bool Run()
+	{
+		if (!FindStructurals()) return false;
+
+		// Every value starts at a structural, so this is an upper bound on the tape length
+		Tape.Words.Reserve(Structurals.Num());
+
+		if (!ParseValue(0)) return false;
+		if (Cursor != Structurals.Num()) return Fail(Structurals[Cursor], TEXT("Unexpected characters after the document"));
+		return true;
+	}
+
+	bool Fail(int32 Offset, const TCHAR* Message)
+	{
+		Tape.Error = FString::Printf(TEXT("%s at byte %d"), Message, Offset);
+		return false;
+	}
+
+	bool FindStructurals()
+	{
+		Structurals.Reserve(Len / 8 + 16);
+
+		uint64 PrevEscaped = 0; // The first byte of this block is escaped by a backslash ending the previous one
+		uint64 PrevInString = 0; // All ones if the previous block ended inside a string
+		uint64 PrevScalar = 0; // The previous block ended inside a number or literal
+
+		uint8 Padded[64];
+		for (int32 BlockStart = 0; BlockStart < Len; BlockStart += 64)
+		{
+			const uint8* Block = Text + BlockStart;
+			if (Len - BlockStart < 64)
+			{
+				// Pad the tail with whitespace, which never changes the structure
+				FMemory::Memset(Padded, ' ', sizeof(Padded));
+				FMemory::Memcpy(Padded, Block, Len - BlockStart);
+				Block = Padded;
+			}
+
+			FJsonBlockMasks Masks;
+			ClassifyBlock(Block, Masks);
+
+			// Backslashes are rare outside of escaped paths, so runs of them are resolved one at a time
+			uint64 Escaped = PrevEscaped;
+			PrevEscaped = 0;
+			for (uint64 Backslashes = Masks.Backslash & ~Escaped; Backslashes != 0; Backslashes &= Backslashes - 1)
+			{
+				const uint64 Bit = Backslashes & (~Backslashes + 1);
+				if (Escaped & Bit) continue;
+
+				if (Bit == (1ull << 63)) PrevEscaped = 1;
+				else Escaped |= Bit << 1;
+			}
+
+			// In-string bits include the opening quote but not the closing one
+			const uint64 Quote = Masks.Quote & ~Escaped;
+			const uint64 InString = PrefixXor(Quote) ^ PrevInString;
+			PrevInString = (uint64)((int64)InString >> 63);
+
+			const uint64 Scalar = ~(Masks.Operator | Masks.Whitespace | Quote);
+			const uint64 ScalarStart = Scalar & ~((Scalar << 1) | PrevScalar);
+			PrevScalar = Scalar >> 63;
+
+			uint64 Bits = (Masks.Operator | ScalarStart | (Quote & InString)) & ~(InString & ~Quote);
+			while (Bits != 0)
+			{
+				Structurals.Add(BlockStart + (int32)FMath::CountTrailingZeros64(Bits));
+				Bits &= Bits - 1;
+			}
+		}
+
+		if (PrevInString) return Fail(Len, TEXT("Unterminated string"));
+		return true;
+	}
+
+	uint8 PeekChar() const
+	{
+		return Cursor < Structurals.Num() ? Text[Structurals[Cursor]] : 0;
+	}
+
+	int32 PeekOffset() const
+	{
+		return Cursor < Structurals.Num() ? Structurals[Cursor] : Len;
+	}
+
+	bool IsDelimiter(int32 Pos) const
+	{
+		if (Pos >= Len) return true;
+
+		switch (Text[Pos])
+		{
+		case ' ': case '\t': case '\n': case '\r': case ',': case '}': case ']':
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	bool ParseValue(int32 Depth)
+	{
+		if (Cursor >= Structurals.Num()) return Fail(Len, TEXT("Unexpected end of input"));
+
+		const int32 Pos = Structurals[Cursor++];
+		switch (Text[Pos])
+		{
+		case '{': return ParseContainer(Pos, Depth, true);
+		case '[': return ParseContainer(Pos, Depth, false);
+		case '"': return ParseString(Pos);
+		case 't': return ParseLiteral(Pos, "true", FJsonTape::EType::True);
+		case 'f': return ParseLiteral(Pos, "false", FJsonTape::EType::False);
+		case 'n': return ParseLiteral(Pos, "null", FJsonTape::EType::Null);
+		default: return ParseNumber(Pos);
+		}
+	}
+
+	bool ParseContainer(int32 Pos, int32 Depth, bool bObject)
+	{
+		if (Depth >= MaxDepth) return Fail(Pos, TEXT("Nesting too deep"));
+
+		const uint8 Close = bObject ? '}' : ']';
+		const int32 StartIndex = Tape.Words.Add(0);
+		uint64 Count = 0;
+
+		if (PeekChar() == Close)
+		{
+			++Cursor;
+		}
+		else
+		{
+			for (;;)
+			{
+				if (bObject)
+				{
+					if (PeekChar() != '"') return Fail(PeekOffset(), TEXT("Expected a string key"));
+					if (!ParseString(Structurals[Cursor++])) return false;
+
+					if (PeekChar() != ':') return Fail(PeekOffset(), TEXT("Expected ':'"));
+					++Cursor;
+				}
+
+				if (!ParseValue(Depth + 1)) return false;
+				++Count;
+
+				const uint8 Separator = PeekChar();
+				if (Separator == Close)
+				{
+					++Cursor;
+					break;
+				}
+				if (Separator != ',') return Fail(PeekOffset(), bObject ? TEXT("Expected ',' or '}'") : TEXT("Expected ',' or ']'"));
+				++Cursor;
+			}
+		}
+
+		const int32 EndIndex = Tape.Words.Add(MakeWord(bObject ? FJsonTape::EType::ObjectEnd : FJsonTape::EType::ArrayEnd, StartIndex));
+		Tape.Words[StartIndex] = MakeWord(bObject ? FJsonTape::EType::ObjectStart : FJsonTape::EType::ArrayStart, (FMath::Min<uint64>(Count, 0xFFFFFF) << 32) | (uint64)EndIndex);
+		return true;
+	}
+
+	bool ParseLiteral(int32 Pos, const ANSICHAR* Literal, FJsonTape::EType Type)
+	{
+		const int32 LiteralLen = FCStringAnsi::Strlen(Literal);
+		if (Pos + LiteralLen > Len || FMemory::Memcmp(Text + Pos, Literal, LiteralLen) != 0 || !IsDelimiter(Pos + LiteralLen))
+		{
+			return Fail(Pos, TEXT("Invalid literal"));
+		}
+
+		Tape.Words.Add(MakeWord(Type, 0));
+		return true;
+	}
+
+	bool ParseNumber(int32 Pos)
+	{
+		auto IsDigit = [this](int32 i) { return i < Len && Text[i] >= '0' && Text[i] <= '9'; };
+
+		int32 i = Pos;
+		const bool bNegative = i < Len && Text[i] == '-';
+		if (bNegative) ++i;
+		if (!IsDigit(i)) return Fail(Pos, TEXT("Invalid value"));
+
+		// Integers of up to 15 digits are exact in a double and skip the generic conversion
+		uint64 Mantissa = 0;
+		int32 NumDigits = 0;
+		if (Text[i] == '0')
+		{
+			++i;
+		}
+		else
+		{
+			for (; IsDigit(i); ++i, ++NumDigits)
+			{
+				Mantissa = Mantissa * 10 + (Text[i] - '0');
+			}
+		}
+
+		bool bIntegral = true;
+		if (i < Len && Text[i] == '.')
+		{
+			bIntegral = false;
+			if (!IsDigit(++i)) return Fail(Pos, TEXT("Invalid number"));
+			while (IsDigit(i)) ++i;
+		}
+		if (i < Len && (Text[i] == 'e' || Text[i] == 'E'))
+		{
+			bIntegral = false;
+			++i;
+			if (i < Len && (Text[i] == '+' || Text[i] == '-')) ++i;
+			if (!IsDigit(i)) return Fail(Pos, TEXT("Invalid number"));
+			while (IsDigit(i)) ++i;
+		}
+		if (!IsDelimiter(i)) return Fail(Pos, TEXT("Invalid number"));
+
+		double Number;
+		if (bIntegral && NumDigits <= 15)
+		{
+			Number = bNegative ? -(double)Mantissa : (double)Mantissa;
+		}
+		else
+		{
+			TArray<ANSICHAR, TInlineAllocator<64>> Buffer;
+			Buffer.Append((const ANSICHAR*)Text + Pos, i - Pos);
+			Buffer.Add('\0');
+			Number = FCStringAnsi::Atod(Buffer.GetData());
+		}
+
+		Tape.Words.Add(MakeWord(FJsonTape::EType::Number, Tape.Numbers.Add(Number)));
+		return true;
+	}
+
+	void AppendCodepoint(uint32 Codepoint)
+	{
+		if constexpr (sizeof(TCHAR) == sizeof(uint16))
+		{
+			if (Codepoint >= 0x10000)
+			{
+				Codepoint -= 0x10000;
+				Tape.Chars.Add((TCHAR)(0xD800 + (Codepoint >> 10)));
+				Tape.Chars.Add((TCHAR)(0xDC00 + (Codepoint & 0x3FF)));
+				return;
+			}
+		}
+		Tape.Chars.Add((TCHAR)Codepoint);
+	}
+
+	bool ParseHex4(int32 Pos, uint32& OutValue) const
+	{
+		if (Pos + 4 > Len) return false;
+
+		OutValue = 0;
+		for (int32 i = Pos; i < Pos + 4; ++i)
+		{
+			const uint8 Char = Text[i];
+			uint32 Digit;
+			if (Char >= '0' && Char <= '9') Digit = Char - '0';
+			else if (Char >= 'a' && Char <= 'f') Digit = Char - 'a' + 10;
+			else if (Char >= 'A' && Char <= 'F') Digit = Char - 'A' + 10;
+			else return false;
+
+			OutValue = (OutValue << 4) | Digit;
+		}
+		return true;
+	}
+
+	bool ParseEscape(int32& i)
+	{
+		const int32 Pos = i;
+		if (i + 1 >= Len) return Fail(Pos, TEXT("Invalid escape"));
+
+		const uint8 Escape = Text[i + 1];
+		i += 2;
+
+		switch (Escape)
+		{
+		case '"': Tape.Chars.Add(TEXT('"')); return true;
+		case '\\': Tape.Chars.Add(TEXT('\\')); return true;
+		case '/': Tape.Chars.Add(TEXT('/')); return true;
+		case 'b': Tape.Chars.Add(TEXT('\b')); return true;
+		case 'f': Tape.Chars.Add(TEXT('\f')); return true;
+		case 'n': Tape.Chars.Add(TEXT('\n')); return true;
+		case 'r': Tape.Chars.Add(TEXT('\r')); return true;
+		case 't': Tape.Chars.Add(TEXT('\t')); return true;
+		case 'u':
+		{
+			uint32 Codepoint;
+			if (!ParseHex4(i, Codepoint)) return Fail(Pos, TEXT("Invalid unicode escape"));
+			i += 4;
+
+			// Join surrogate pairs; a lone surrogate is kept as is, like TJsonReader does
+			uint32 Low;
+			if (Codepoint >= 0xD800 && Codepoint < 0xDC00 && i + 1 < Len && Text[i] == '\\' && Text[i + 1] == 'u'
+				&& ParseHex4(i + 2, Low) && Low >= 0xDC00 && Low < 0xE000)
+			{
+				Codepoint = 0x10000 + ((Codepoint - 0xD800) << 10) + (Low - 0xDC00);
+				i += 6;
+			}
+			AppendCodepoint(Codepoint);
+			return true;
+		}
+		default:
+			return Fail(Pos, TEXT("Invalid escape"));
+		}
+	}
+
+	bool ParseMultiByteChar(int32& i)
+	{
+		const uint8 Lead = Text[i];
+		int32 NumContinuation;
+		uint32 Codepoint;
+		uint32 MinCodepoint;
+		if ((Lead & 0xE0) == 0xC0) { NumContinuation = 1; Codepoint = Lead & 0x1F; MinCodepoint = 0x80; }
+		else if ((Lead & 0xF0) == 0xE0) { NumContinuation = 2; Codepoint = Lead & 0x0F; MinCodepoint = 0x800; }
+		else if ((Lead & 0xF8) == 0xF0) { NumContinuation = 3; Codepoint = Lead & 0x07; MinCodepoint = 0x10000; }
+		else return Fail(i, TEXT("Invalid UTF-8"));
+
+		if (i + NumContinuation >= Len) return Fail(i, TEXT("Invalid UTF-8"));
+		for (int32 k = 1; k <= NumContinuation; ++k)
+		{
+			const uint8 Continuation = Text[i + k];
+			if ((Continuation & 0xC0) != 0x80) return Fail(i, TEXT("Invalid UTF-8"));
+			Codepoint = (Codepoint << 6) | (Continuation & 0x3F);
+		}
+		// Overlong forms and encoded UTF-16 surrogates are invalid UTF-8
+		if (Codepoint < MinCodepoint
+			|| Codepoint > 0x10FFFF
+			|| (Codepoint >= 0xD800 && Codepoint <= 0xDFFF))
+		{
+			return Fail(i, TEXT("Invalid UTF-8"));
+		}
+
+		i += NumContinuation + 1;
+		AppendCodepoint(Codepoint);
+		return true;
+	}
+
+	bool ParseString(int32 Pos)
+	{
+		const int32 Offset = Tape.Chars.Num();
+
+		int32 i = Pos + 1;
+		for (;;)
+		{
+			// Widen the plain ASCII run up to the next quote, escape, control or multi-byte character in one go
+			int32 RunEnd = i;
+			while (RunEnd < Len && Text[RunEnd] >= 0x20 && Text[RunEnd] < 0x80 && Text[RunEnd] != '"' && Text[RunEnd] != '\\')
+			{
+				++RunEnd;
+			}
+			if (RunEnd > i)
+			{
+				const int32 DestIndex = Tape.Chars.AddUninitialized(RunEnd - i);
+				TCHAR* Dest = Tape.Chars.GetData() + DestIndex;
+				for (int32 k = i; k < RunEnd; ++k)
+				{
+					*Dest++ = (TCHAR)Text[k];
+				}
+				i = RunEnd;
+			}
+
+			if (i >= Len) return Fail(Pos, TEXT("Unterminated string"));
+
+			const uint8 Char = Text[i];
+			if (Char == '"') break;
+			if (Char < 0x20) return Fail(i, TEXT("Control character in string"));
+
+			if (!(Char == '\\' ? ParseEscape(i) : ParseMultiByteChar(i))) return false;
+		}
+
+		Tape.Strings.Add({ Offset, Tape.Chars.Num() - Offset });
+		Tape.Words.Add(MakeWord(FJsonTape::EType::String, Tape.Strings.Num() - 1));
+		return true;
+	}
+};
+
+bool FJsonTape::Parse(TArrayView<const uint8> Utf8Json)
+{
+	Words.Reset();
+	Numbers.Reset();
+	Strings.Reset();
+	Chars.Reset();
+	Error.Reset();
+
+	// Skip a byte order mark
+	if (Utf8Json.Num() >= 3 && Utf8Json[0] == 0xEF && Utf8Json[1] == 0xBB && Utf8Json[2] == 0xBF)
+	{
+		Utf8Json = Utf8Json.Slice(3, Utf8Json.Num() - 3);
+	}
+
+	FJsonTapeParser Parser(*this, Utf8Json);
+	return Parser.Run();
+}
+
+// MATERIALIZATION
+
+static FString MakeString(const TArray<TCHAR>& Chars, int32 Offset, int32 Len)
+{
+	FString String;
+	if (Len > 0)
+	{
+		TArray<TCHAR>& StringChars = String.GetCharArray();
+		StringChars.SetNumUninitialized(Len + 1);
+		FMemory::Memcpy(StringChars.GetData(), Chars.GetData() + Offset, Len * sizeof(TCHAR));
+		StringChars[Len] = TEXT('\0');
+	}
+	return String;
+}
+
+TSharedPtr<FJsonObject> FJsonTape::ToJsonObject() const
+{
+	if (Words.Num() == 0 || GetWordType(Words[0]) != EType::ObjectStart) return nullptr;
+
+	int32 Index = 0;
+	return MakeObject(Index);
+}
+
+TSharedPtr<FJsonValue> FJsonTape::ToJsonValue(int32 Index) const
+{
+	return MakeValue(Index);
+}
+
+TSharedPtr<FJsonObject> FJsonTape::MakeObject(int32& Index) const
+{
+	const int32 Count = (int32)(GetWordPayload(Words[Index++]) >> 32);
+
+	TSharedPtr<FJsonObject> Object = MakeShared<FJsonObject>();
+	Object->Values.Reserve(Count);
+	while (GetWordType(Words[Index]) != EType::ObjectEnd)
+	{
+		const FStringSpan& Key = Strings[GetWordPayload(Words[Index++])];
+		FString KeyString = MakeString(Chars, Key.Offset, Key.Len);
+		Object->Values.Add(MoveTemp(KeyString), MakeValue(Index));
+	}
+	++Index;
+
+	return Object;
+}
+
+TSharedPtr<FJsonValue> FJsonTape::MakeValue(int32& Index) const
+{
+	const uint64 Word = Words[Index];
+	switch (GetWordType(Word))
+	{
+	case EType::ObjectStart:
+		return MakeShared<FJsonValueObject>(MakeObject(Index));
+	case EType::ArrayStart:
+	{
+		++Index;
+		TArray<TSharedPtr<FJsonValue>> Values;
+		Values.Reserve((int32)(GetWordPayload(Word) >> 32));
+		while (GetWordType(Words[Index]) != EType::ArrayEnd)
+		{
+			Values.Add(MakeValue(Index));
+		}
+		++Index;
+		return MakeShared<FJsonValueArray>(MoveTemp(Values));
+	}
+	case EType::Number:
+		++Index;
+		return MakeShared<FJsonValueNumber>(Numbers[GetWordPayload(Word)]);
+	case EType::String:
+	{
+		++Index;
+		const FStringSpan& Span = Strings[GetWordPayload(Word)];
+		return MakeShared<FJsonValueString>(MakeString(Chars, Span.Offset, Span.Len));
+	}
+	case EType::True:
+	case EType::False:
+		++Index;
+		return MakeShared<FJsonValueBoolean>(GetWordType(Word) == EType::True);
+	default:
+		++Index;
+		return MakeShared<FJsonValueNull>();
+	}
+}
+
+// NAVIGATION
+
+FJsonTape::EType FJsonTape::GetType(int32 Index) const
+{
+	return GetWordType(Words[Index]);
+}
+
+int32 FJsonTape::Next(int32 Index) const
+{
+	const uint64 Word = Words[Index];
+	switch (GetWordType(Word))
+	{
+	case EType::ArrayStart:
+	case EType::ObjectStart:
+		return (int32)(GetWordPayload(Word) & 0xFFFFFFFF) + 1;
+	default:
+		return Index + 1;
+	}
+}
+
+int32 FJsonTape::GetCount(int32 Index) const
+{
+	const int32 Count = (int32)(GetWordPayload(Words[Index]) >> 32);
+	if (Count < 0xFFFFFF) return Count;
+
+	// The stored count saturates, so walk larger containers
+	const bool bObject = GetType(Index) == EType::ObjectStart;
+	const int32 EndIndex = Next(Index) - 1;
+	int32 NumElements = 0;
+	for (int32 Element = Index + 1; Element < EndIndex; Element = Next(bObject ? Element + 1 : Element))
+	{
+		++NumElements;
+	}
+	return NumElements;
+}
+
+double FJsonTape::GetNumber(int32 Index) const
+{
+	return Numbers[GetWordPayload(Words[Index])];
+}
+
+FStringView FJsonTape::GetString(int32 Index) const
+{
+	const FStringSpan& Span = Strings[GetWordPayload(Words[Index])];
+	return FStringView(Chars.GetData() + Span.Offset, Span.Len);
+}
+
+int32 FJsonTape::FindField(int32 Index, FStringView Key) const
+{
+	int32 Found = INDEX_NONE;
+	for (int32 KeyIndex = Index + 1; GetType(KeyIndex) != EType::ObjectEnd; KeyIndex = Next(KeyIndex + 1))
+	{
+		if (GetString(KeyIndex).Equals(Key, ESearchCase::IgnoreCase))
+		{
+			Found = KeyIndex + 1;
+		}
+	}
+	return Found;
+}
@@ -0,0 +1,87 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+
+/**
+ * A parsed json document laid out as a flat tape, in the style of simdjson.
+ *
+ * Parsing runs in two stages. The first classifies the input 64 bytes at a time with vector compares, resolving
+ * escapes and string extents with bit arithmetic, and records the offset of every structural character and value
+ * start. The second walks only those offsets to fill the tape: one 64-bit word per value, with containers holding
+ * their element count and the index of their end word. Strings and numbers are decoded into side tables.
+ *
+ * The tape can be read in place: values are addressed by the index of their first word, the root being at 0, and
+ * containers are skipped in one step. Object fields are a string key word followed by the value.
+ *
+ * A tape can be reused for several documents, e.g. the lines of an NDJSON file, to keep its allocations.
+ */
+class FJsonTape
+{
+public:
+	enum class EType : uint8
+	{
+		Null,
+		True,
+		False,
+		Number,
+		String,
+		ArrayStart,
+		ArrayEnd,
+		ObjectStart,
+		ObjectEnd,
+	};
+
+	/** Parses one json document from UTF-8 text, replacing the tape's contents. Returns false and sets Error if it's malformed. */
+	bool Parse(TArrayView<const uint8> Utf8Json);
+
+	/** Builds a DOM from the tape, with every container reserved to its final size. Null unless the root is an object. */
+	TSharedPtr<FJsonObject> ToJsonObject() const;
+
+	/** Builds a DOM value from the value at Index, for code that needs an FJsonValue. */
+	TSharedPtr<FJsonValue> ToJsonValue(int32 Index) const;
+
+	EType GetType(int32 Index) const;
+
+	/** Index of the value or field key following the value at Index. */
+	int32 Next(int32 Index) const;
+
+	/** Number of elements, or fields, of the array or object starting at Index. */
+	int32 GetCount(int32 Index) const;
+
+	double GetNumber(int32 Index) const;
+
+	/** The decoded string at Index. Only valid until the tape is parsed again. */
+	FStringView GetString(int32 Index) const;
+
+	/**
+	 * Index of the value of the field named Key in the object starting at Index, or INDEX_NONE. Keys are compared
+	 * like FJsonObject does, ignoring case, and the last of duplicate keys wins.
+	 */
+	int32 FindField(int32 Index, FStringView Key) const;
+
+	/** Why the last Parse failed, including the byte offset. */
+	FString Error;
+
+private:
+	friend struct FJsonTapeParser;
+
+	struct FStringSpan
+	{
+		int32 Offset;
+		int32 Len;
+	};
+
+	TSharedPtr<FJsonValue> MakeValue(int32& Index) const;
+	TSharedPtr<FJsonObject> MakeObject(int32& Index) const;
+
+	// Type in the top byte. Numbers and strings hold their side table index; container starts hold their element
+	// count (saturated to 24 bits) above the index of their end word; container ends hold the index of their start
+	TArray<uint64> Words;
+	TArray<double> Numbers;
+	TArray<FStringSpan> Strings;
+	TArray<TCHAR> Chars;
+};
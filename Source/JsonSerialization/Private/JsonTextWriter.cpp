@@ -0,0 +1,207 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "JsonTextWriter.h"
+
+#define JSON_TEXT_WRITER_SSE2 (PLATFORM_ENABLE_VECTORINTRINSICS && PLATFORM_CPU_X86_FAMILY)
+#define JSON_TEXT_WRITER_NEON (PLATFORM_ENABLE_VECTORINTRINSICS_NEON && PLATFORM_CPU_ARM_FAMILY)
+
+#if JSON_TEXT_WRITER_SSE2
+#include <emmintrin.h>
+#elif JSON_TEXT_WRITER_NEON
+#include <arm_neon.h>
+#endif
+
+#include <charconv>
+
+// Shortest round-trip number formatting, where the standard library has the floating point overloads
+#if defined(__cpp_lib_to_chars)
+#define JSON_TEXT_WRITER_TO_CHARS 1
+#else
+#define JSON_TEXT_WRITER_TO_CHARS 0
+#endif
+
+void FJsonTextWriter::WriteObject(const FJsonObject& Object, FString& Out)
+{
+	Out.AppendChar(TEXT('{'));
+
+	bool bFirst = true;
+	for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : Object.Values)
+	{
+		if (!bFirst) Out.AppendChar(TEXT(','));
+		bFirst = false;
+
+		WriteString(Pair.Key, Out);
+		Out.AppendChar(TEXT(':'));
+		WriteValue(Pair.Value, Out);
+	}
+
+	Out.AppendChar(TEXT('}'));
+}
+
+void FJsonTextWriter::WriteValue(const TSharedPtr<FJsonValue>& Value, FString& Out)
+{
+	switch (Value.IsValid() ? Value->Type : EJson::Null)
+	{
+	case EJson::Boolean:
+		Out += Value->AsBool() ? TEXT("true") : TEXT("false");
+		break;
+	case EJson::Number:
+		WriteNumber(Value->AsNumber(), Out);
+		break;
+	case EJson::String:
+		WriteString(Value->AsString(), Out);
+		break;
+	case EJson::Array:
+	{
+		Out.AppendChar(TEXT('['));
+		bool bFirst = true;
+		for (const TSharedPtr<FJsonValue>& Element : Value->AsArray())
+		{
+			if (!bFirst) Out.AppendChar(TEXT(','));
+			bFirst = false;
+			WriteValue(Element, Out);
+		}
+		Out.AppendChar(TEXT(']'));
+		break;
+	}
+	case EJson::Object:
+		WriteObject(*Value->AsObject(), Out);
+		break;
+	default:
+		Out += TEXT("null");
+		break;
+	}
+}
+
+static bool NeedsEscape(TCHAR Char)
+{
+	return Char < 0x20 || Char == TEXT('"') || Char == TEXT('\\');
+}
+
+// Returns the index of the first character at or after Start that needs escaping, or Len. Checks eight UTF-16
+// characters per step where vector intrinsics are available; most strings have nothing to escape at all.
+static int32 FindNextEscape(const TCHAR* Chars, int32 Start, int32 Len)
+{
+	int32 i = Start;
+
+#if JSON_TEXT_WRITER_SSE2 || JSON_TEXT_WRITER_NEON
+	if constexpr (sizeof(TCHAR) == sizeof(uint16))
+	{
+#if JSON_TEXT_WRITER_SSE2
+		const __m128i Quote = _mm_set1_epi16('"');
+		const __m128i Backslash = _mm_set1_epi16('\\');
+		const __m128i LastControl = _mm_set1_epi16(0x1f);
+		for (; i + 8 <= Len; i += 8)
+		{
+			const __m128i Block = _mm_loadu_si128((const __m128i*)(Chars + i));
+			// Saturating subtract is zero exactly for characters <= 0x1f, an unsigned compare SSE2 lacks
+			const __m128i Control = _mm_cmpeq_epi16(_mm_subs_epu16(Block, LastControl), _mm_setzero_si128());
+			const __m128i Special = _mm_or_si128(_mm_cmpeq_epi16(Block, Quote), _mm_cmpeq_epi16(Block, Backslash));
+			if (_mm_movemask_epi8(_mm_or_si128(Control, Special)) != 0) break;
+		}
+#else
+		const uint16x8_t Quote = vdupq_n_u16('"');
+		const uint16x8_t Backslash = vdupq_n_u16('\\');
+		const uint16x8_t FirstPrintable = vdupq_n_u16(0x20);
+		for (; i + 8 <= Len; i += 8)
+		{
+			const uint16x8_t Block = vld1q_u16((const uint16*)(Chars + i));
+			const uint16x8_t Special = vorrq_u16(vcltq_u16(Block, FirstPrintable), vorrq_u16(vceqq_u16(Block, Quote), vceqq_u16(Block, Backslash)));
+			if (vmaxvq_u16(Special) != 0) break;
+		}
+#endif
+	}
+#endif
+
+	// The tail, and the block a match was found in
+	for (; i < Len; ++i)
+	{
+		if (NeedsEscape(Chars[i])) break;
+	}
+	return i;
+}
+
+void FJsonTextWriter::WriteString(const FString& String, FString& Out)
+{
+	const TCHAR* Chars = *String;
+	const int32 Len = String.Len();
+
+	Out.AppendChar(TEXT('"'));
+
+	// Copy unescaped runs in one go
+	int32 RunStart = 0;
+	for (int32 i = FindNextEscape(Chars, 0, Len); i < Len; i = FindNextEscape(Chars, i + 1, Len))
+	{
+		const TCHAR Char = Chars[i];
+
+		Out.AppendChars(Chars + RunStart, i - RunStart);
+		RunStart = i + 1;
+
+		switch (Char)
+		{
+		case TEXT('"'): Out += TEXT("\\\""); break;
+		case TEXT('\\'): Out += TEXT("\\\\"); break;
+		case TEXT('\b'): Out += TEXT("\\b"); break;
+		case TEXT('\f'): Out += TEXT("\\f"); break;
+		case TEXT('\n'): Out += TEXT("\\n"); break;
+		case TEXT('\r'): Out += TEXT("\\r"); break;
+		case TEXT('\t'): Out += TEXT("\\t"); break;
+		default: Out.Appendf(TEXT("\\u%04x"), (uint32)Char); break;
+		}
+	}
+	Out.AppendChars(Chars + RunStart, Len - RunStart);
+
+	Out.AppendChar(TEXT('"'));
+}
+
+void FJsonTextWriter::WriteNumber(double Number, FString& Out)
+{
+	if (!FMath::IsFinite(Number))
+	{
+		Out += TEXT("null");
+	}
+	else if (FMath::Abs(Number) < 9007199254740992.0 && FMath::TruncToDouble(Number) == Number)
+	{
+		// Integral values that fit a double's mantissa are written without an exponent or fraction
+		Out.Appendf(TEXT("%lld"), (int64)Number);
+	}
+	else
+	{
+#if JSON_TEXT_WRITER_TO_CHARS
+		// Shortest digits that read back as the same double
+		ANSICHAR Buffer[32];
+		const std::to_chars_result Result = std::to_chars(Buffer, Buffer + UE_ARRAY_COUNT(Buffer), Number);
+		Out.AppendChars(Buffer, int32(Result.ptr - Buffer));
+#else
+		// 17 significant digits always read back as the same double
+		Out.Appendf(TEXT("%.17g"), Number);
+#endif
+	}
+}
+
+double FJsonTextWriter::WidenFloat(float Value)
+{
+	if (!FMath::IsFinite(Value))
+	{
+		return Value;
+	}
+
+	double Widened = Value;
+#if JSON_TEXT_WRITER_TO_CHARS
+	ANSICHAR Buffer[32];
+	const std::to_chars_result Result = std::to_chars(Buffer, Buffer + UE_ARRAY_COUNT(Buffer), Value);
+	std::from_chars(Buffer, Result.ptr, Widened);
+#else
+	// Fewest of 6 to 9 significant digits that read back as the same float; 9 always do
+	TCHAR Buffer[32];
+	for (int32 Precision = 6; Precision <= 9; ++Precision)
+	{
+		FCString::Snprintf(Buffer, UE_ARRAY_COUNT(Buffer), TEXT("%.*g"), Precision, (double)Value);
+		Widened = FCString::Atod(Buffer);
+		if ((float)Widened == Value) break;
+	}
+#endif
+
+	// Reading the digits as a double and then narrowing can round differently from reading them as a float
+	return (float)Widened == Value ? Widened : (double)Value;
+}
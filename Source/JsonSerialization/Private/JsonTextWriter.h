@@ -0,0 +1,26 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+
+/**
+ * Writes a json DOM as condensed text, appending straight to a string the caller has already sized.
+ * Strings are scanned for characters to escape eight at a time where vector intrinsics are available, and numbers
+ * are written with the fewest digits that read back as the same double where the standard library can format them.
+ */
+struct FJsonTextWriter
+{
+	static void WriteObject(const FJsonObject& Object, FString& Out);
+	static void WriteValue(const TSharedPtr<FJsonValue>& Value, FString& Out);
+	static void WriteString(const FString& String, FString& Out);
+	static void WriteNumber(double Number, FString& Out);
+
+	/**
+	 * Returns the double written with the same shortest digits as Value, e.g. 0.1 for 0.1f instead of
+	 * 0.100000001490116. Narrowing the result gives Value back. Use it to put floats in the DOM.
+	 */
+	static double WidenFloat(float Value);
+};
@@ -0,0 +1,474 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "JsonWorldSnapshot.h"
+
+#include "JsonClassPlan.h"
+#include "JsonTape.h"
+#include "JsonSerialization.h"
+#include "Components/ActorComponent.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Actor.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformMisc.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+#include <atomic>
+
+static const int32 SnapshotManifestVersion = 2;
+
+// Work items per worker. More items give the stealing room to even out bad estimates, fewer keep overhead down
+static const int32 SnapshotWorkItemsPerWorker = 8;
+
+// Estimated output bytes per actor, components included, by actor class path, learned from previous snapshots. Only touched on the game thread
+static TMap<FString, double> LearnedClassCosts;
+
+struct FSnapshotWorkItem
+{
+	int32 FirstObject = 0;
+	int32 NumObjects = 0;
+	double Cost = 0.0;
+};
+
+struct FSnapshotWorkQueue
+{
+	FCriticalSection Lock;
+	TArray<int32> Items;
+	int32 Head = 0;
+	int32 Tail = 0;
+
+	// The owner takes items from the front, which holds the most expensive ones
+	bool Pop(int32& OutItem)
+	{
+		FScopeLock ScopeLock(&Lock);
+		if (Head == Tail) return false;
+		OutItem = Items[Head++];
+		return true;
+	}
+
+	// Thieves take from the back so they don't contend with the owner for the same end
+	bool Steal(int32& OutItem)
+	{
+		FScopeLock ScopeLock(&Lock);
+		if (Head == Tail) return false;
+		OutItem = Items[--Tail];
+		return true;
+	}
+};
+
+struct FSnapshotShard
+{
+	FString FileName;
+	int32 NumObjects = 0;
+	int64 NumBytes = 0;
+
+	// Output bytes of actors and their components, and actor count, per actor class, fed back into LearnedClassCosts
+	TMap<const UClass*, TPair<int64, int32>> ClassSamples;
+};
+
+class FSnapshotWorkerRunnable : public FRunnable
+{
+public:
+	FSnapshotWorkerRunnable(TFunctionRef<void(int32)> InBody, int32 InWorkerIndex)
+		: Body(InBody)
+		, WorkerIndex(InWorkerIndex)
+	{
+	}
+
+	virtual uint32 Run() override
+	{
+		Body(WorkerIndex);
+		return 0;
+	}
+
+private:
+	TFunctionRef<void(int32)> Body;
+	int32 WorkerIndex;
+};
+
+// Runs Body once per worker index on dedicated threads, the calling thread being worker 0, and returns when all are
+// done. Not ParallelFor: dedicated servers don't use the task graph for performance, so it would run every worker on
+// the calling thread, and they spawn only a handful of task graph workers anyway
+static void RunSnapshotWorkers(int32 NumWorkers, TFunctionRef<void(int32)> Body)
+{
+	TArray<TUniquePtr<FSnapshotWorkerRunnable>> Runnables;
+	TArray<TUniquePtr<FRunnableThread>> Threads;
+	TArray<int32> InlineWorkers;
+
+	for (int32 WorkerIndex = 1; WorkerIndex < NumWorkers; ++WorkerIndex)
+	{
+		FRunnableThread* Thread = nullptr;
+		if (FPlatformProcess::SupportsMultithreading())
+		{
+			FSnapshotWorkerRunnable* Runnable = Runnables.Emplace_GetRef(MakeUnique<FSnapshotWorkerRunnable>(Body, WorkerIndex)).Get();
+			Thread = FRunnableThread::Create(Runnable, *FString::Printf(TEXT("JsonSnapshotWorker%d"), WorkerIndex));
+		}
+
+		if (Thread) Threads.Emplace(Thread);
+		else InlineWorkers.Add(WorkerIndex);
+	}
+
+	Body(0);
+	for (int32 WorkerIndex : InlineWorkers)
+	{
+		Body(WorkerIndex);
+	}
+	for (TUniquePtr<FRunnableThread>& Thread : Threads)
+	{
+		Thread->WaitForCompletion();
+	}
+}
+
+static bool PassesClassFilter(const UObject* Object, const TArray<TSubclassOf<UObject>>& ClassFilter)
+{
+	if (ClassFilter.Num() == 0) return true;
+
+	for (const TSubclassOf<UObject>& Class : ClassFilter)
+	{
+		if (Class && Object->IsA(Class)) return true;
+	}
+	return false;
+}
+
+// Actors with their components. An actor passes the filter if one of its components does
+static void GatherSnapshotActors(UWorld* World, const TArray<TSubclassOf<UObject>>& ClassFilter, TArray<const AActor*>& OutActors)
+{
+	for (TActorIterator<AActor> It(World); It; ++It)
+	{
+		AActor* Actor = *It;
+		bool bPasses = PassesClassFilter(Actor, ClassFilter);
+		if (!bPasses)
+		{
+			Actor->ForEachComponent(false, [&bPasses, &ClassFilter](UActorComponent* Component)
+			{
+				bPasses = bPasses || PassesClassFilter(Component, ClassFilter);
+			});
+		}
+
+		if (bPasses)
+		{
+			OutActors.Add(Actor);
+		}
+	}
+}
+
+static double EstimatePropertiesCost(const UClass* Class)
+{
+	return 64.0 + 48.0 * FJsonClassPlan::Get(Class)->Properties.Num();
+}
+
+static double EstimateActorCost(const AActor* Actor, TMap<const UClass*, double>& CostCache)
+{
+	const UClass* Class = Actor->GetClass();
+	if (const double* Cached = CostCache.Find(Class))
+	{
+		return *Cached;
+	}
+
+	double Cost;
+	if (const double* Learned = LearnedClassCosts.Find(Class->GetPathName()))
+	{
+		Cost = *Learned;
+	}
+	else
+	{
+		// Nothing learned yet, guess from the number of serialized properties of the actor and its components
+		Cost = EstimatePropertiesCost(Class);
+		Actor->ForEachComponent(false, [&Cost](UActorComponent* Component)
+		{
+			Cost += EstimatePropertiesCost(Component->GetClass());
+		});
+	}
+
+	CostCache.Add(Class, Cost);
+	return Cost;
+}
+
+// Splits the actors into consecutive runs of roughly equal estimated cost, then deals them out largest first
+static void BuildSnapshotWorkQueues(const TArray<const AActor*>& Actors, int32 NumWorkers, TArray<FSnapshotWorkItem>& OutItems, TArray<FSnapshotWorkQueue>& OutQueues)
+{
+	TMap<const UClass*, double> CostCache;
+	TArray<double> ObjectCosts;
+	ObjectCosts.Reserve(Actors.Num());
+
+	double TotalCost = 0.0;
+	for (const AActor* Actor : Actors)
+	{
+		TotalCost += ObjectCosts.Add_GetRef(EstimateActorCost(Actor, CostCache));
+	}
+
+	const double TargetCost = TotalCost / (NumWorkers * SnapshotWorkItemsPerWorker);
+	FSnapshotWorkItem Item;
+	for (int32 i = 0; i < Actors.Num(); ++i)
+	{
+		Item.NumObjects++;
+		Item.Cost += ObjectCosts[i];
+		if (Item.Cost >= TargetCost || i == Actors.Num() - 1)
+		{
+			OutItems.Add(Item);
+			Item = FSnapshotWorkItem();
+			Item.FirstObject = i + 1;
+		}
+	}
+
+	TArray<int32> Order;
+	Order.Reserve(OutItems.Num());
+	for (int32 i = 0; i < OutItems.Num(); ++i)
+	{
+		Order.Add(i);
+	}
+	Order.Sort([&OutItems](int32 A, int32 B) { return OutItems[A].Cost > OutItems[B].Cost; });
+
+	OutQueues.SetNum(NumWorkers);
+	for (int32 i = 0; i < Order.Num(); ++i)
+	{
+		OutQueues[i % NumWorkers].Items.Add(Order[i]);
+	}
+	for (FSnapshotWorkQueue& Queue : OutQueues)
+	{
+		Queue.Tail = Queue.Items.Num();
+	}
+}
+
+// Writes one line and returns its length in bytes
+static int64 WriteSnapshotLine(const UObject* Object, TSharedPtr<FJsonObject> JsonObject, FArchive& Writer, FSnapshotShard& Shard)
+{
+	JsonObject->SetStringField(FJsonSerializerFields::ObjectNameField.ToString(), Object->GetPathName());
+
+	FString Line;
+	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> JsonWriter = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Line);
+	FJsonSerializer::Serialize(JsonObject.ToSharedRef(), JsonWriter);
+	Line += TEXT('\n');
+
+	FTCHARToUTF8 Utf8(*Line, Line.Len());
+	Writer.Serialize((void*)Utf8.Get(), Utf8.Length());
+
+	Shard.NumObjects++;
+	Shard.NumBytes += Utf8.Length();
+	return Utf8.Length();
+}
+
+static void WriteSnapshotActor(const AActor* Actor, const FJsonWorldSnapshotSettings& Settings, FArchive& Writer, FSnapshotShard& Shard)
+{
+	TSet<const UObject*> InlinedObjects;
+	TSharedPtr<FJsonObject> JsonObject = FJsonSerializationModule::SerializeUObjectToJson(Actor, InlinedObjects, Settings.bIncludeObjectClasses, Settings.bPositionalProperties);
+	int64 NumBytes = WriteSnapshotLine(Actor, JsonObject, Writer, Shard);
+
+	// Components that no property of the actor points to, e.g. ones created at runtime or native subobjects without
+	// a UPROPERTY member, are only in OwnedComponents and weren't inlined, so they get lines of their own
+	Actor->ForEachComponent(false, [&](UActorComponent* Component)
+	{
+		if (!InlinedObjects.Contains(Component))
+		{
+			TSet<const UObject*> ComponentInlinedObjects;
+			JsonObject = FJsonSerializationModule::SerializeUObjectToJson(Component, ComponentInlinedObjects, Settings.bIncludeObjectClasses, Settings.bPositionalProperties);
+			NumBytes += WriteSnapshotLine(Component, JsonObject, Writer, Shard);
+			InlinedObjects.Append(ComponentInlinedObjects);
+		}
+	});
+
+	TPair<int64, int32>& Sample = Shard.ClassSamples.FindOrAdd(Actor->GetClass());
+	Sample.Key += NumBytes;
+	Sample.Value++;
+}
+
+static bool WriteSnapshotManifest(const FString& ManifestPath, const UWorld* World, const TArray<FSnapshotShard>& Shards, const FJsonWorldSnapshotResult& Result)
+{
+	TArray<TSharedPtr<FJsonValue>> ShardValues;
+	ShardValues.Reserve(Shards.Num());
+	for (const FSnapshotShard& Shard : Shards)
+	{
+		TSharedPtr<FJsonObject> ShardObject = MakeShared<FJsonObject>();
+		ShardObject->SetStringField(TEXT("File"), Shard.FileName);
+		ShardObject->SetNumberField(TEXT("NumObjects"), Shard.NumObjects);
+		ShardObject->SetNumberField(TEXT("NumBytes"), Shard.NumBytes);
+		ShardValues.Emplace(MakeShared<FJsonValueObject>(ShardObject));
+	}
+
+	TSharedPtr<FJsonObject> Manifest = MakeShared<FJsonObject>();
+	Manifest->SetNumberField(TEXT("Version"), SnapshotManifestVersion);
+	Manifest->SetStringField(TEXT("World"), World->GetPathName());
+	Manifest->SetNumberField(TEXT("NumObjects"), Result.NumObjects);
+	Manifest->SetNumberField(TEXT("NumBytes"), Result.NumBytes);
+	Manifest->SetArrayField(TEXT("Shards"), ShardValues);
+
+	FString ManifestText;
+	FJsonSerializer::Serialize(Manifest.ToSharedRef(), TJsonWriterFactory<>::Create(&ManifestText));
+	return FFileHelper::SaveStringToFile(ManifestText, *ManifestPath);
+}
+
+FJsonWorldSnapshotResult FJsonWorldSnapshot::Export(UWorld* World, const FJsonWorldSnapshotSettings& Settings)
+{
+	check(IsInGameThread());
+
+	FJsonWorldSnapshotResult Result;
+	if (World == nullptr || !IFileManager::Get().MakeDirectory(*Settings.OutputDirectory, true))
+	{
+		return Result;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	const int32 NumWorkers = Settings.NumWorkers > 0 ? Settings.NumWorkers : FPlatformMisc::NumberOfCoresIncludingHyperthreads();
+
+	TArray<const AActor*> Actors;
+	GatherSnapshotActors(World, Settings.ClassFilter, Actors);
+
+	TArray<FSnapshotWorkItem> Items;
+	TArray<FSnapshotWorkQueue> Queues;
+	BuildSnapshotWorkQueues(Actors, NumWorkers, Items, Queues);
+
+	TArray<FSnapshotShard> Shards;
+	Shards.SetNum(NumWorkers);
+	std::atomic<bool> bWriteFailed(false);
+
+	RunSnapshotWorkers(NumWorkers, [&](int32 WorkerIndex)
+	{
+		FSnapshotShard& Shard = Shards[WorkerIndex];
+		Shard.FileName = FString::Printf(TEXT("Shard_%03d.ndjson"), WorkerIndex);
+
+		TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*FPaths::Combine(Settings.OutputDirectory, Shard.FileName)));
+		if (!Writer)
+		{
+			bWriteFailed = true;
+			return;
+		}
+
+		int32 ItemIndex;
+		for (;;)
+		{
+			bool bFound = Queues[WorkerIndex].Pop(ItemIndex);
+			for (int32 Offset = 1; !bFound && Offset < NumWorkers; ++Offset)
+			{
+				bFound = Queues[(WorkerIndex + Offset) % NumWorkers].Steal(ItemIndex);
+			}
+			if (!bFound) break;
+
+			const FSnapshotWorkItem& Item = Items[ItemIndex];
+			for (int32 i = Item.FirstObject; i < Item.FirstObject + Item.NumObjects; ++i)
+			{
+				WriteSnapshotActor(Actors[i], Settings, *Writer, Shard);
+			}
+		}
+
+		if (!Writer->Close())
+		{
+			bWriteFailed = true;
+		}
+	});
+
+	for (const FSnapshotShard& Shard : Shards)
+	{
+		Result.NumObjects += Shard.NumObjects;
+		Result.NumBytes += Shard.NumBytes;
+
+		for (const TPair<const UClass*, TPair<int64, int32>>& Sample : Shard.ClassSamples)
+		{
+			const double Cost = double(Sample.Value.Key) / Sample.Value.Value;
+			double& Learned = LearnedClassCosts.FindOrAdd(Sample.Key->GetPathName(), Cost);
+			Learned = 0.5 * (Learned + Cost);
+		}
+	}
+
+	Result.ManifestPath = FPaths::Combine(Settings.OutputDirectory, TEXT("Manifest.json"));
+	Result.bSuccess = !bWriteFailed && WriteSnapshotManifest(Result.ManifestPath, World, Shards, Result);
+	Result.Seconds = FPlatformTime::Seconds() - StartTime;
+
+	UE_LOG(LogJsonSerialization, Log, TEXT("World snapshot of %s: %d objects, %lld bytes in %d shards, %.3fs"),
+		*World->GetName(), Result.NumObjects, Result.NumBytes, NumWorkers, Result.Seconds);
+
+	return Result;
+}
+
+static bool LoadSnapshotShard(const FString& ShardPath, TArray<TSharedPtr<FJsonObject>>& OutObjects)
+{
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *ShardPath)) return false;
+
+	// One tape for the whole shard, so its buffers are reused from line to line
+	FJsonTape Tape;
+	int32 LineStart = 0;
+	while (LineStart < Bytes.Num())
+	{
+		int32 LineEnd = LineStart;
+		while (LineEnd < Bytes.Num() && Bytes[LineEnd] != '\n') ++LineEnd;
+
+		if (LineEnd > LineStart)
+		{
+			TSharedPtr<FJsonObject> JsonObject;
+			if (!Tape.Parse(TArrayView<const uint8>(Bytes.GetData() + LineStart, LineEnd - LineStart)) || !(JsonObject = Tape.ToJsonObject()).IsValid())
+			{
+				UE_LOG(LogJsonSerialization, Warning, TEXT("Failed to parse %s: %s"), *ShardPath, *Tape.Error);
+				return false;
+			}
+			OutObjects.Emplace(MoveTemp(JsonObject));
+		}
+		LineStart = LineEnd + 1;
+	}
+	return true;
+}
+
+bool FJsonWorldSnapshot::Load(const FString& ManifestPath, TArray<TSharedPtr<FJsonObject>>& OutObjects)
+{
+	FString ManifestText;
+	if (!FFileHelper::LoadFileToString(ManifestText, *ManifestPath)) return false;
+
+	TSharedPtr<FJsonObject> Manifest;
+	if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(ManifestText), Manifest) || !Manifest.IsValid()) return false;
+
+	const TArray<TSharedPtr<FJsonValue>>* ShardValues = nullptr;
+	if (!Manifest->TryGetArrayField(TEXT("Shards"), ShardValues)) return false;
+
+	const FString Directory = FPaths::GetPath(ManifestPath);
+	TArray<TArray<TSharedPtr<FJsonObject>>> ShardObjects;
+	ShardObjects.SetNum(ShardValues->Num());
+	std::atomic<bool> bReadFailed(false);
+	std::atomic<int32> NextShard(0);
+
+	const int32 NumWorkers = FMath::Min(ShardValues->Num(), FPlatformMisc::NumberOfCoresIncludingHyperthreads());
+	RunSnapshotWorkers(NumWorkers, [&](int32 WorkerIndex)
+	{
+		for (int32 ShardIndex = NextShard++; ShardIndex < ShardValues->Num(); ShardIndex = NextShard++)
+		{
+			const TSharedPtr<FJsonObject>* ShardObject = nullptr;
+			FString FileName;
+			if (!(*ShardValues)[ShardIndex]->TryGetObject(ShardObject) || !(*ShardObject)->TryGetStringField(TEXT("File"), FileName))
+			{
+				bReadFailed = true;
+				continue;
+			}
+
+			int32 NumObjects = 0;
+			(*ShardObject)->TryGetNumberField(TEXT("NumObjects"), NumObjects);
+			ShardObjects[ShardIndex].Reserve(NumObjects);
+
+			if (!LoadSnapshotShard(FPaths::Combine(Directory, FileName), ShardObjects[ShardIndex]))
+			{
+				bReadFailed = true;
+			}
+		}
+	});
+
+	if (bReadFailed) return false;
+
+	int32 TotalObjects = 0;
+	for (const TArray<TSharedPtr<FJsonObject>>& Objects : ShardObjects)
+	{
+		TotalObjects += Objects.Num();
+	}
+
+	OutObjects.Reserve(OutObjects.Num() + TotalObjects);
+	for (TArray<TSharedPtr<FJsonObject>>& Objects : ShardObjects)
+	{
+		OutObjects.Append(MoveTemp(Objects));
+	}
+	return true;
+}
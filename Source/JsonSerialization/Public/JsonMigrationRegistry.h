@@ -0,0 +1,47 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonValue.h"
+
+struct FJsonClassPlan;
+
+/** Converts a json value written by an older version of a class into the form its current property reads. Return null to skip the value. */
+using FJsonValueConverter = TFunction<TSharedPtr<FJsonValue>(const TSharedPtr<FJsonValue>& OldValue)>;
+
+/**
+ * Maps json written by older versions of a class or struct onto its current properties, so old documents are
+ * remapped during the normal deserialization pass instead of being fixed up beforehand.
+ *
+ * Migrations are registered by struct path, apply to subclasses, and are resolved into the struct's plan when it is
+ * built. Properties without migrations pay nothing. A renamed property's old keys are only looked up when its current
+ * key is missing, and a retyped property's converter only runs on values of the old json type.
+ *
+ * Renames are applied before retypes regardless of registration order, so a value found under an old key also goes
+ * through the retype converters. Several old keys are tried, and several retypes chained, in registration order.
+ */
+class JSONSERIALIZATION_API FJsonMigrationRegistry
+{
+public:
+	/**
+	 * Reads values written under OldKey into Property when the document doesn't have Property's current key.
+	 * Property is the property's name or authored name. Converter, if set, is applied to the old value first.
+	 */
+	static void AddRenamedProperty(const UStruct* Struct, const FString& OldKey, FName Property, FJsonValueConverter Converter = nullptr);
+
+	/** Passes values of Property written as OldType through Converter before they are read. */
+	static void AddRetypedProperty(const UStruct* Struct, FName Property, EJson OldType, FJsonValueConverter Converter);
+
+	/** Drops every migration registered for Struct itself. */
+	static void RemoveMigrations(const UStruct* Struct);
+
+private:
+	friend struct FJsonClassPlan;
+
+	/** Fills Plan.Migrations from the migrations registered for its struct and the struct's parents. */
+	static void ResolveMigrations(FJsonClassPlan& Plan);
+
+	/** Changes whenever a migration is added or removed, so plans built meanwhile aren't cached. */
+	static uint32 GetGeneration();
+};
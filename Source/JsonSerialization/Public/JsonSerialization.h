@@ -6,6 +6,31 @@
 #include "Dom/JsonObject.h"
 #include "Modules/ModuleManager.h"
 
+JSONSERIALIZATION_API DECLARE_LOG_CATEGORY_EXTERN(LogJsonSerialization, Log, All);
+
+struct JSONSERIALIZATION_API FJsonSerializationBudget
+{
+	/** Estimated bytes the json DOM may take before serialization stops. 0 disables the budget. */
+	int64 MaxDomBytes = 0;
+
+	/** When set, an object over budget is streamed to this archive as UTF-8 json instead of being built as a DOM. */
+	FArchive* SpillArchive = nullptr;
+};
+
+struct JSONSERIALIZATION_API FJsonSerializationReport
+{
+	/** Estimated size of the DOM, up to the point serialization stopped. */
+	int64 EstimatedDomBytes = 0;
+
+	bool bBudgetExceeded = false;
+
+	/** The object was written to the spill archive instead of being returned. */
+	bool bSpilled = false;
+
+	/** Path of the property whose value went over budget, e.g. "Inventory.Items[1204].Name". */
+	FString ExceededPropertyPath;
+};
+
 class JSONSERIALIZATION_API FJsonSerializationModule : public IModuleInterface
 {
 public:
@@ -14,18 +39,69 @@ public:
 	virtual void StartupModule() override;
 	virtual void ShutdownModule() override;
 
-	
 
-	static TSharedPtr<FJsonObject> SerializeUObjectToJson(const UObject* Object, bool bIncludeObjectClasses = false, bool bChangedPropertiesOnly = false);
+
+	/**
+	 * Serializes an object and its owned subobjects to json.
+	 *
+	 * bPositionalProperties writes object bodies as arrays ordered by the class layout instead of keyed objects, and
+	 * adds a root "Schemas" table holding each class's fingerprint and property names once per document. It implies
+	 * bIncludeObjectClasses, so read it back with bIncludeObjectClasses = true. Only use it when the reader runs the
+	 * same build; a reader whose fingerprint differs falls back to matching values by name through the schema table.
+	 *
+	 * Float properties deliberately differ from FJsonObjectConverter: their json number is the double with the
+	 * float's shortest round-trip digits, e.g. 0.1 for 0.1f rather than the converter's exact widening,
+	 * 0.100000001490116. Both convert back to the same float.
+	 */
+	static TSharedPtr<FJsonObject> SerializeUObjectToJson(const UObject* Object, bool bIncludeObjectClasses = false, bool bChangedPropertiesOnly = false, bool bPositionalProperties = false);
+	/**
+	 * Serializes to condensed json text. The output is reserved up front from the text length of earlier objects of
+	 * the same class, so repeated calls write into a single allocation.
+	 */
+	static void SerializeUObjectToJsonString(const UObject* Object, FString& OutJson, bool bIncludeObjectClasses = false, bool bChangedPropertiesOnly = false, bool bPositionalProperties = false);
+
+	/**
+	 * Like SerializeUObjectToJson, but stops building the DOM once its estimated size exceeds Budget.MaxDomBytes.
+	 * The partial DOM is freed, the offending property path is reported, and the object is streamed to
+	 * Budget.SpillArchive if one is set. Returns null whenever the budget was exceeded.
+	 */
+	static TSharedPtr<FJsonObject> SerializeUObjectToJsonWithBudget(const UObject* Object, const FJsonSerializationBudget& Budget, FJsonSerializationReport& OutReport, bool bIncludeObjectClasses = false, bool bChangedPropertiesOnly = false, bool bPositionalProperties = false);
+
+	/** Writes the same json as SerializeUObjectToJson to Archive as UTF-8, property by property, without building a DOM. */
+	static bool SerializeUObjectToJsonStream(const UObject* Object, FArchive& Archive, bool bIncludeObjectClasses = false, bool bChangedPropertiesOnly = false, bool bPositionalProperties = false);
+
+	/**
+	 * Reads json written by the functions above into Object. Keyed bodies are read into every property they have a
+	 * key for, including transient ones, which are never written.
+	 */
 	static void DeserializeJsonToUObject(UObject*& Object, TSharedPtr<FJsonObject> JsonObject, bool bIncludeObjectClasses = false);
+
+	/**
+	 * Parses UTF-8 json text with the plugin's structural-index parser, reading the bytes directly instead of converting
+	 * them to a TCHAR string first. Returns null, logging the byte offset of the error, if the text isn't a json object.
+	 */
+	static TSharedPtr<FJsonObject> ParseUtf8Json(TArrayView<const uint8> Utf8Json);
+
+	/**
+	 * Parses Utf8Json like ParseUtf8Json and deserializes it into Object straight from the parser's tape, without
+	 * building an FJsonObject DOM. Json values are only created for properties read through FJsonObjectConverter and
+	 * for properties with migrations. Returns false if the text couldn't be parsed.
+	 */
+	static bool DeserializeUtf8JsonToUObject(UObject*& Object, TArrayView<const uint8> Utf8Json, bool bIncludeObjectClasses = false);
+
+private:
+	friend class FJsonWorldSnapshot;
+
+	/** SerializeUObjectToJson that also returns the objects it wrote inline: Object and the subobjects it owns. */
+	static TSharedPtr<FJsonObject> SerializeUObjectToJson(const UObject* Object, TSet<const UObject*>& OutInlinedObjects, bool bIncludeObjectClasses, bool bPositionalProperties);
+
+	FDelegateHandle ObjectsReplacedHandle;
 };
 
-struct FJsonSerializerFields {
+struct JSONSERIALIZATION_API FJsonSerializerFields {
 	static const FName ObjectClassField;
 	static const FName ObjectNameField;
 	static const FName ObjectPropertiesField;
+	static const FName ObjectSchemaField;
+	static const FName SchemasField;
 };
-
-const FName FJsonSerializerFields::ObjectClassField = FName("Class");
-const FName FJsonSerializerFields::ObjectNameField = FName("Name");
-const FName FJsonSerializerFields::ObjectPropertiesField = FName("Properties");
\ No newline at end of file
@@ -0,0 +1,56 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "Templates/SubclassOf.h"
+
+class UWorld;
+
+struct JSONSERIALIZATION_API FJsonWorldSnapshotSettings
+{
+	/** Directory the shards and the manifest are written to. */
+	FString OutputDirectory;
+
+	/** Actors of these classes, or with a component of these classes, are captured. Empty captures every actor. */
+	TArray<TSubclassOf<UObject>> ClassFilter;
+
+	/** Number of worker threads, and therefore shard files. 0 uses one per logical core, the calling thread included. */
+	int32 NumWorkers = 0;
+
+	bool bIncludeObjectClasses = true;
+	bool bPositionalProperties = false;
+};
+
+struct JSONSERIALIZATION_API FJsonWorldSnapshotResult
+{
+	bool bSuccess = false;
+	int32 NumObjects = 0;
+	int64 NumBytes = 0;
+	double Seconds = 0.0;
+	FString ManifestPath;
+};
+
+/**
+ * Full-state dumps of the actors in a world.
+ *
+ * Actors are split into work items balanced by a per-class cost estimate, which is learned from the output size
+ * of previous snapshots. Each worker writes its own NDJSON shard, one actor per line with its components inlined,
+ * followed by a line for each component no property of the actor points to, e.g. one created at runtime. A worker
+ * steals work items from other workers once its own queue is empty. Workers are dedicated threads, not task
+ * graph tasks, since dedicated servers run the task graph with few workers and ParallelFor on the calling thread.
+ * A manifest lists the shards so they can be reloaded in parallel.
+ */
+class JSONSERIALIZATION_API FJsonWorldSnapshot
+{
+public:
+	/**
+	 * Captures World into Settings.OutputDirectory. Must be called from the game thread, which is blocked until
+	 * every shard is written, so the world can't change while workers read it.
+	 */
+	static FJsonWorldSnapshotResult Export(UWorld* World, const FJsonWorldSnapshotSettings& Settings);
+
+	/** Reads a manifest written by Export and parses its shards on worker threads, returning objects in shard order. */
+	static bool Load(const FString& ManifestPath, TArray<TSharedPtr<FJsonObject>>& OutObjects);
+};